@@ -1,118 +1,175 @@
-#include <cmath>
-#include <set>
-#include <map>
-#include "mesh/mesh.h"
-#include "mesh/geometry.h"
+#include "CatmullClark.h"
 
-using namespace mesh;
+SubdivisionMesh toSubdivisionMesh(Mesh& mesh) {
+  SubdivisionMesh result;
+  result.vertices = mesh.get_vertices();
+  result.face_offsets = mesh.get_face_offsets();
+  result.face_indices = mesh.get_face_indices();
+  return result;
+}
 
-Mesh catmullClark(int n){
-  Mesh base = unitCircleCube();
-  for (int i = 0; i < n; i++) {
-    // New mesh
-    std::vector<Face3D> new_faces;
-    std::vector<Face3D> faces = base.get_faces();
-    // Vertex related points
-    std::map<Vertex3D, std::set<Vertex3D>> vertex_edgepoints;
-    std::map<Vertex3D, std::set<Vertex3D>> vertex_facepoints;
-    for (Vertex3D v : base.get_vertices()) {
-      vertex_edgepoints[v] = {};
-      vertex_facepoints[v] = {};
-    }
+// One level of subdivision.
+// New vertices are laid out as [moved corners][face points][edge points]
+SubdivisionMesh catmullClarkStep(const SubdivisionMesh& mesh) {
+  int vertex_count = mesh.vertices.size();
+  int face_count = mesh.face_offsets.size() - 1;
+  int corner_count = mesh.face_indices.size();
 
-    // Loop faces
-    for (auto f : faces) {
-      // Get Face points
-      Vertex3D face_midpoint = f.get_midpoint();
-      // Add face point to map
-      for (auto v : f.vertices) {
-        vertex_facepoints[v].insert(face_midpoint);
-      }
-      // Get Edge points
-      std::vector<Vertex3D> edge_newpoints;
-      std::vector<Edge3D> edges = f.get_edges();
-      for (auto e : edges) {
-        // Get faces with edge
-        std::vector<Face3D> faces_with_edge = base.get_faces_with_edge(e);
-        // Get values
-        Vertex3D v0 = e.v1;
-        Vertex3D v1 = e.v2;
-        Vertex3D fm0 = faces_with_edge[0].get_midpoint();
-        Vertex3D fm1 = faces_with_edge[1].get_midpoint();
-        // Get edge
-        Vertex3D edge_point = {
-          (v0.x + v1.x + fm0.x + fm1.x) / 4.0f,
-          (v0.y + v1.y + fm0.y + fm1.y) / 4.0f,
-          (v0.z + v1.z + fm0.z + fm1.z) / 4.0f
-        };
-        edge_newpoints.push_back(edge_point);
-        // Add edge midpoints to map
-        Vertex3D edge_midpoint = e.get_midpoint();
-        vertex_edgepoints[v0].insert(edge_midpoint);
-        vertex_edgepoints[v1].insert(edge_midpoint);
+  // Edges: corner c is the edge from its vertex to the next vertex of its face
+  std::vector<int> corner_edge(corner_count);
+  std::vector<int> edge_v0, edge_v1, edge_f0, edge_f1;
+  edge_v0.reserve(corner_count / 2 + 1);
+  edge_v1.reserve(corner_count / 2 + 1);
+  edge_f0.reserve(corner_count / 2 + 1);
+  edge_f1.reserve(corner_count / 2 + 1);
+  // Faces of an edge and the sum of the face points after the second one,
+  // which only non-manifold edges have
+  std::vector<int> edge_face_count;
+  std::vector<Vertex3D> edge_extra_sum;
+  edge_face_count.reserve(corner_count / 2 + 1);
+  edge_extra_sum.reserve(corner_count / 2 + 1);
+  std::unordered_map<std::uint64_t, int> edge_ids;
+  edge_ids.reserve(corner_count);
+
+  // Face points
+  std::vector<Vertex3D> face_points(face_count);
+  // Per vertex sums: face points, edge midpoints, boundary neighbors
+  std::vector<Vertex3D> face_sum(vertex_count);
+  std::vector<int> face_valence(vertex_count, 0);
+  std::vector<Vertex3D> edge_sum(vertex_count);
+  std::vector<int> edge_valence(vertex_count, 0);
+  std::vector<Vertex3D> boundary_sum(vertex_count);
+  std::vector<int> boundary_valence(vertex_count, 0);
+
+  for (int f = 0; f < face_count; f++) {
+    int begin = mesh.face_offsets[f];
+    int end = mesh.face_offsets[f + 1];
+    int n = end - begin;
+    Vertex3D midpoint = {0, 0, 0};
+    for (int c = begin; c < end; c++) {
+      midpoint = midpoint + mesh.vertices[mesh.face_indices[c]];
+    }
+    midpoint = midpoint / n;
+    face_points[f] = midpoint;
+    for (int c = begin; c < end; c++) {
+      int v0 = mesh.face_indices[c];
+      int v1 = mesh.face_indices[begin + (c - begin + 1) % n];
+      face_sum[v0] = face_sum[v0] + midpoint;
+      face_valence[v0]++;
+      // Find or create the edge
+      std::uint64_t key = v0 < v1
+        ? ((std::uint64_t)v0 << 32) | (std::uint32_t)v1
+        : ((std::uint64_t)v1 << 32) | (std::uint32_t)v0;
+      auto inserted = edge_ids.emplace(key, (int)edge_v0.size());
+      if (inserted.second) {
+        edge_v0.push_back(v0);
+        edge_v1.push_back(v1);
+        edge_f0.push_back(f);
+        edge_f1.push_back(-1);
+        edge_face_count.push_back(1);
+        edge_extra_sum.push_back(Vertex3D(0, 0, 0));
       }
-      // Get new faces
-      for (int i = 0; i < f.vertices.size(); i++) {
-        Vertex3D v0 = f.vertices[i];
-        Vertex3D v1 = edge_newpoints[i];
-        Vertex3D v2 = face_midpoint;
-        Vertex3D v3 = edge_newpoints[(i + f.vertices.size() - 1) % f.vertices.size()];
-        new_faces.push_back(Face3D({v0, v1, v2, v3}));
+      else {
+        int e = inserted.first->second;
+        if (edge_face_count[e] == 1) {
+          edge_f1[e] = f;
+        }
+        else {
+          edge_extra_sum[e] = edge_extra_sum[e] + midpoint;
+        }
+        edge_face_count[e]++;
       }
+      corner_edge[c] = inserted.first->second;
+    }
+  }
+  int edge_count = edge_v0.size();
+
+  // Edge points
+  std::vector<Vertex3D> edge_points(edge_count);
+  for (int e = 0; e < edge_count; e++) {
+    const Vertex3D& a = mesh.vertices[edge_v0[e]];
+    const Vertex3D& b = mesh.vertices[edge_v1[e]];
+    Vertex3D midpoint = (a + b) / 2.0;
+    edge_sum[edge_v0[e]] = edge_sum[edge_v0[e]] + midpoint;
+    edge_sum[edge_v1[e]] = edge_sum[edge_v1[e]] + midpoint;
+    edge_valence[edge_v0[e]]++;
+    edge_valence[edge_v1[e]]++;
+    if (edge_f1[e] == -1) {
+      // Boundary edge: keep the midpoint
+      edge_points[e] = midpoint;
+      boundary_sum[edge_v0[e]] = boundary_sum[edge_v0[e]] + b;
+      boundary_sum[edge_v1[e]] = boundary_sum[edge_v1[e]] + a;
+      boundary_valence[edge_v0[e]]++;
+      boundary_valence[edge_v1[e]]++;
+    }
+    else if (edge_face_count[e] == 2) {
+      edge_points[e] = (a + b + face_points[edge_f0[e]] + face_points[edge_f1[e]]) / 4.0;
+    }
+    else {
+      // Non-manifold edge: average of its ends and all its face points
+      edge_points[e] = (a + b + face_points[edge_f0[e]] + face_points[edge_f1[e]] + edge_extra_sum[e]) / (edge_face_count[e] + 2.0);
+    }
+  }
+
+  SubdivisionMesh result;
+  result.vertices.reserve(vertex_count + face_count + edge_count);
+  // Update vertices
+  for (int v = 0; v < vertex_count; v++) {
+    const Vertex3D& p = mesh.vertices[v];
+    int n = edge_valence[v];
+    if (boundary_valence[v] == 2) {
+      // Boundary: 3/4 P + 1/8 (A + B)
+      result.vertices.push_back(p * 0.75 + boundary_sum[v] * 0.125);
     }
-    // Get original points
-    auto corners = base.get_vertices();
-    // Update base
-    base = Mesh(new_faces);
-    // Update vertices
-    for (auto corner: corners) {
-      std::set<Vertex3D> edgepoints = vertex_edgepoints[corner];
-      std::set<Vertex3D> facepoints = vertex_facepoints[corner];
+    else if (boundary_valence[v] > 0 || n < 3) {
+      // Non-manifold corner or isolated vertex: keep it
+      result.vertices.push_back(p);
+    }
+    else {
       // F + 2R + (n-3)P / n
       // F=Average of face points
       // R=Average of edge midpoints
       // P=Current point
       // n=Number of edges/face
-      int n = edgepoints.size();
-      //std::cout << "corner: " << corner.x << " " << corner.y << " " << corner.z << std::endl;
-      //std::cout << "n: " << n << std::endl;
-      //std::cout << "facepoints: " << facepoints.size() << std::endl;
-      //std::cout << "edgepoints: " << edgepoints.size() << std::endl;
-
-      Vertex3D face_avg = {0, 0, 0};
-      Vertex3D edge_avg = {0, 0, 0};
-      for (auto f : facepoints) {
-        face_avg.x += f.x;
-        face_avg.y += f.y;
-        face_avg.z += f.z;
-      }
-      for (auto e : edgepoints) {
-        edge_avg.x += e.x;
-        edge_avg.y += e.y;
-        edge_avg.z += e.z;
-      }
-      face_avg.x /= n;
-      face_avg.y /= n;
-      face_avg.z /= n;
-      edge_avg.x /= n;
-      edge_avg.y /= n;
-      edge_avg.z /= n;
-      Vertex3D new_point = {
-        (face_avg.x + 2*edge_avg.x + (n-3)*corner.x) / n,
-        (face_avg.y + 2*edge_avg.y + (n-3)*corner.y) / n,
-        (face_avg.z + 2*edge_avg.z + (n-3)*corner.z) / n
-      };
-
-      base.move_point(corner, new_point);
+      Vertex3D face_avg = face_sum[v] / face_valence[v];
+      Vertex3D edge_avg = edge_sum[v] / n;
+      result.vertices.push_back((face_avg + edge_avg * 2 + p * (n - 3)) / n);
     }
+  }
+  result.vertices.insert(result.vertices.end(), face_points.begin(), face_points.end());
+  result.vertices.insert(result.vertices.end(), edge_points.begin(), edge_points.end());
 
+  // New faces: one quad per corner
+  int face_point_base = vertex_count;
+  int edge_point_base = vertex_count + face_count;
+  result.face_offsets.reserve(corner_count + 1);
+  result.face_indices.reserve(corner_count * 4);
+  result.face_offsets.push_back(0);
+  for (int f = 0; f < face_count; f++) {
+    int begin = mesh.face_offsets[f];
+    int end = mesh.face_offsets[f + 1];
+    int n = end - begin;
+    for (int c = begin; c < end; c++) {
+      int previous = begin + (c - begin + n - 1) % n;
+      result.face_indices.push_back(mesh.face_indices[c]);
+      result.face_indices.push_back(edge_point_base + corner_edge[c]);
+      result.face_indices.push_back(face_point_base + f);
+      result.face_indices.push_back(edge_point_base + corner_edge[previous]);
+      result.face_offsets.push_back(result.face_indices.size());
+    }
   }
-  return base;
+  return result;
+}
 
+Mesh catmullClark(Mesh& base, int n) {
+  SubdivisionMesh current = toSubdivisionMesh(base);
+  for (int i = 0; i < n; i++) {
+    current = catmullClarkStep(current);
+  }
+  return Mesh(current.vertices, std::move(current.face_offsets), std::move(current.face_indices));
 }
 
-int main() {
-  Mesh sphere = catmullClark(5);
-  sphere.save_ply("outputs/ck.ply");
-  return 0;
-}
\ No newline at end of file
+Mesh catmullClark(int n) {
+  Mesh base = unitCircleCube();
+  return catmullClark(base, n);
+}
@@ -0,0 +1,25 @@
+#ifndef CATMULLCLARK_H
+#define CATMULLCLARK_H
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include "mesh.h"
+#include "geometry.h"
+
+using namespace mesh;
+
+// Flat polygon mesh used by the subdivision engine.
+// Face f uses face_indices[face_offsets[f]] .. face_indices[face_offsets[f + 1] - 1]
+struct SubdivisionMesh {
+  std::vector<Vertex3D> vertices;
+  std::vector<int> face_offsets;
+  std::vector<int> face_indices;
+};
+
+SubdivisionMesh toSubdivisionMesh(Mesh& mesh);
+SubdivisionMesh catmullClarkStep(const SubdivisionMesh& mesh);
+Mesh catmullClark(Mesh& base, int n);
+Mesh catmullClark(int n);
+
+#endif
@@ -1,39 +1,69 @@
 #include "SplittingEdges.h"
 
 
-Mesh sphereBySplittingEdges(int n){
-  Mesh base = unitCircleTetrahedron();
+Mesh sphereBySplittingEdges(Mesh& base, int n){
+  // Index buffer of the triangles. Polygons are split in a fan around their
+  // first vertex, faces with fewer than 3 vertices are skipped
+  std::vector<Vertex3D> vertices = base.get_vertices();
+  std::vector<int> triangles;
+  triangles.reserve(base.get_face_count() * 3);
+  for (int f = 0; f < base.get_face_count(); f++) {
+    IndexSpan ids = base.get_face_vertex_ids(f);
+    for (int i = 1; i + 1 < ids.size(); i++) {
+      triangles.insert(triangles.end(), {ids[0], ids[i], ids[i + 1]});
+    }
+  }
   for (int i = 0; i < n; i++) {
-    // New mesh
-    std::vector<Face3D> new_faces;
+    // Midpoint cache: each edge is split once and shared by both faces
+    std::unordered_map<std::uint64_t, int> midpoints;
+    midpoints.reserve(triangles.size() / 2);
+    auto getMidpoint = [&](int a, int b) {
+      std::uint64_t key = a < b
+        ? ((std::uint64_t)a << 32) | (std::uint32_t)b
+        : ((std::uint64_t)b << 32) | (std::uint32_t)a;
+      auto inserted = midpoints.emplace(key, (int)vertices.size());
+      if (inserted.second) {
+        Vertex3D va = vertices[a];
+        Vertex3D vb = vertices[b];
+        vertices.push_back(Vertex3D((va.x + vb.x)/2, (va.y + vb.y)/2, (va.z + vb.z)/2).normalized());
+      }
+      return inserted.first->second;
+    };
+    // New faces
+    std::vector<int> new_triangles;
+    new_triangles.reserve(triangles.size() * 4);
     // Loop faces
-    for (Face3D face : base.get_faces()) {
+    for (size_t t = 0; t < triangles.size(); t += 3) {
       // Get vertices
-      Vertex3D v0 = face.vertices[0];
-      Vertex3D v1 = face.vertices[1];
-      Vertex3D v2 = face.vertices[2];
+      int v0 = triangles[t];
+      int v1 = triangles[t + 1];
+      int v2 = triangles[t + 2];
       // Get new vertices
-      Vertex3D v01 = Vertex3D((v0.x + v1.x)/2, (v0.y + v1.y)/2, (v0.z + v1.z)/2).normalized();
-      Vertex3D v12 = Vertex3D((v1.x + v2.x)/2, (v1.y + v2.y)/2, (v1.z + v2.z)/2).normalized();
-      Vertex3D v20 = Vertex3D((v2.x + v0.x)/2, (v2.y + v0.y)/2, (v2.z + v0.z)/2).normalized();
+      int v01 = getMidpoint(v0, v1);
+      int v12 = getMidpoint(v1, v2);
+      int v20 = getMidpoint(v2, v0);
       // Insert new faces
-      new_faces.push_back(Face3D({v0, v01, v20}));
-      new_faces.push_back(Face3D({v1, v12, v01}));
-      new_faces.push_back(Face3D({v2, v20, v12}));
-      new_faces.push_back(Face3D({v01, v12, v20}));
+      new_triangles.insert(new_triangles.end(), {v0, v01, v20});
+      new_triangles.insert(new_triangles.end(), {v1, v12, v01});
+      new_triangles.insert(new_triangles.end(), {v2, v20, v12});
+      new_triangles.insert(new_triangles.end(), {v01, v12, v20});
     }
-    // Update base
-    base = Mesh(new_faces);
+    triangles.swap(new_triangles);
   }
-  return base;
-
+  // Every face is a triangle
+  std::vector<int> face_offsets(triangles.size() / 3 + 1);
+  for (size_t f = 0; f < face_offsets.size(); f++) {
+    face_offsets[f] = f * 3;
+  }
+  return Mesh(vertices, std::move(face_offsets), std::move(triangles));
 }
 
+Mesh sphereBySplittingEdges(int n){
+  Mesh base = unitCircleTetrahedron();
+  return sphereBySplittingEdges(base, n);
+}
 
-/*
-int main() {
-  Mesh sphere = sphereBySplittingEdges(3);
-  sphere.save_ply("outputs/sphere.ply");
-  return 0;
+Mesh icosphere(int n){
+  Mesh base = unitCircleIcosahedron();
+  return sphereBySplittingEdges(base, n);
 }
-*/
\ No newline at end of file
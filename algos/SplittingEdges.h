@@ -2,13 +2,19 @@
 #define SPLITTINGEDGES_H
 
 #include <cmath>
+#include <cstdint>
+#include <unordered_map>
 #include "mesh.h"
 #include "geometry.h"
 
 using namespace mesh;
 
 
+// Splits every triangle of base in 4, projecting the new vertices on the unit sphere.
+// Polygons of base are fan triangulated first
+Mesh sphereBySplittingEdges(Mesh& base, int n);
 Mesh sphereBySplittingEdges(int n);
+Mesh icosphere(int n);
 
 #endif
 
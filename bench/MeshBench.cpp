@@ -0,0 +1,58 @@
+// Microbenchmark: vertex welding when building a Mesh from Face3D
+// Compares the hash indexed Mesh constructor against the previous linear search
+#include <chrono>
+#include "mesh.h"
+#include "SplittingEdges.h"
+#include "CatmullClark.h"
+
+using namespace mesh;
+
+// Previous implementation: std::find over all the vertices for each inserted vertex
+size_t linearWeld(const std::vector<Face3D>& faces) {
+  std::vector<Vertex3D> vertices;
+  std::vector<std::vector<int>> indexes;
+  for (const Face3D& face : faces) {
+    std::vector<int> face_indexes;
+    for (const Vertex3D& vertex : face.vertices) {
+      auto it = std::find(vertices.begin(), vertices.end(), vertex);
+      if (it == vertices.end()) {
+        vertices.push_back(vertex);
+        face_indexes.push_back(vertices.size() - 1);
+      }
+      else {
+        face_indexes.push_back(it - vertices.begin());
+      }
+    }
+    indexes.push_back(face_indexes);
+  }
+  return vertices.size();
+}
+
+template <typename F>
+double timeMs(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void benchWelding(const std::string& name, const std::vector<Face3D>& faces) {
+  size_t linear_vertices = 0;
+  size_t hashed_vertices = 0;
+  double linear_ms = timeMs([&]() { linear_vertices = linearWeld(faces); });
+  double hashed_ms = timeMs([&]() { hashed_vertices = Mesh(faces).get_vertices().size(); });
+  std::cout << name << ": " << faces.size() << " faces" << std::endl;
+  std::cout << "  linear: " << linear_ms << " ms (" << linear_vertices << " vertices)" << std::endl;
+  std::cout << "  hashed: " << hashed_ms << " ms (" << hashed_vertices << " vertices)" << std::endl;
+  std::cout << "  speedup: " << linear_ms / hashed_ms << "x" << std::endl;
+}
+
+int main() {
+  for (int n = 3; n <= 6; n++) {
+    benchWelding("sphereBySplittingEdges(" + std::to_string(n) + ")", sphereBySplittingEdges(n).get_faces());
+  }
+  for (int n = 2; n <= 4; n++) {
+    benchWelding("catmullClark(" + std::to_string(n) + ")", catmullClark(n).get_faces());
+  }
+  return 0;
+}
@@ -0,0 +1,36 @@
+// Benchmark: PLY loading through iostreams against the memory mapped parser
+// on a 1M faces sphere, in ASCII and binary
+#include <chrono>
+#include "mesh.h"
+#include "SplittingEdges.h"
+
+using namespace mesh;
+
+template <typename F>
+double timeMs(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void benchLoading(const std::string& name, const std::string& filename) {
+  int stream_faces = 0;
+  int mapped_faces = 0;
+  double stream_ms = timeMs([&]() { stream_faces = Mesh(filename, PLY_LOAD_STREAM).get_face_count(); });
+  double mapped_ms = timeMs([&]() { mapped_faces = Mesh(filename, PLY_LOAD_MAPPED).get_face_count(); });
+  std::cout << name << ":" << std::endl;
+  std::cout << "  stream: " << stream_ms << " ms (" << stream_faces << " faces)" << std::endl;
+  std::cout << "  mapped: " << mapped_ms << " ms (" << mapped_faces << " faces)" << std::endl;
+  std::cout << "  speedup: " << stream_ms / mapped_ms << "x" << std::endl;
+}
+
+int main() {
+  // 4 * 4^9 = 1048576 triangles
+  Mesh sphere = sphereBySplittingEdges(9);
+  sphere.save_ply("outputs/bench_ascii.ply", PLY_ASCII);
+  sphere.save_ply("outputs/bench_binary.ply", PLY_BINARY_LITTLE_ENDIAN);
+  benchLoading("ascii", "outputs/bench_ascii.ply");
+  benchLoading("binary_little_endian", "outputs/bench_binary.ply");
+  return 0;
+}
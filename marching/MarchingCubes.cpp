@@ -6,9 +6,15 @@
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <unordered_map>
+#include <cstdint>
+#include <chrono>
+#include <thread>
 #include "mesh.h"
 #include "composite.h"
 #include "geometry.h"
+#include "parallel.h"
+#include "MarchingCubesTable.h"
 
 #define DEBUG_COLOR
 
@@ -23,10 +29,8 @@ Vertex3D getCenter(const CubeVertexes& cube) {
   return (cube[0] + cube[6]) / 2.0;
 }
 
-Vertex3D weightedMidpoint(const Vertex3D& a, const Vertex3D& b, std::function<double(double, double, double)> func) {
-  double value_a = func(a.x, a.y, a.z);
-  double value_b = func(b.x, b.y, b.z);
-
+// Zero crossing between a and b from the field values at both ends
+Vertex3D weightedMidpoint(const Vertex3D& a, const Vertex3D& b, double value_a, double value_b) {
   if (value_a == 0 && value_b == 0) {
     return (a + b) / 2.0;
   }
@@ -44,6 +48,11 @@ Vertex3D weightedMidpoint(const Vertex3D& a, const Vertex3D& b, std::function<do
   return a + atob * t;
 }
 
+template <typename F>
+Vertex3D weightedMidpoint(const Vertex3D& a, const Vertex3D& b, const F& func) {
+  return weightedMidpoint(a, b, func(a.x, a.y, a.z), func(b.x, b.y, b.z));
+}
+
 
 double getSign(double value) {
   if (value == 0) {
@@ -58,9 +67,10 @@ double getColor(double value) {
   return value > 0 ? 1 : 0;
 }
 
+template <typename F>
 double getColor(
-  std::function<double(double, double, double)> func,
-  CubeVertexes cube,
+  const F& func,
+  const CubeVertexes& cube,
   size_t index) {
   auto x = cube[index].x;
   auto y = cube[index].y;
@@ -286,7 +296,8 @@ std::vector<std::vector<size_t>> getAdyacentColoredVertices(const CubeColors& co
 }
 
 
-std::vector<Face3D> getFacesVertex1(const CubeVertexes& cube, std::vector<size_t> vertex_indexes, std::function<double(double, double, double)> func) {
+template <typename F>
+std::vector<Face3D> getFacesVertex1(const CubeVertexes& cube, std::vector<size_t> vertex_indexes, const F& func) {
   auto vertex_index = vertex_indexes[0];
   // Get neighbors
   Vertex3D vertex = cube[vertex_index];
@@ -313,7 +324,8 @@ std::vector<Face3D> getFacesVertex1(const CubeVertexes& cube, std::vector<size_t
 
 }
 
-std::vector<Face3D> getFacesVertex2(const CubeVertexes& cube, std::vector<size_t> vertex_indexes, std::function<double(double, double, double)> func) {
+template <typename F>
+std::vector<Face3D> getFacesVertex2(const CubeVertexes& cube, std::vector<size_t> vertex_indexes, const F& func) {
   // Get points
   size_t i1 = vertex_indexes[0];
   size_t i2 = vertex_indexes[1];
@@ -357,7 +369,8 @@ std::vector<Face3D> getFacesVertex2(const CubeVertexes& cube, std::vector<size_t
   };
 }
 
-std::vector<Face3D> getFacesVertex3(const CubeVertexes& cube, std::vector<size_t> vertex_indexes, std::function<double(double, double, double)> func) {
+template <typename F>
+std::vector<Face3D> getFacesVertex3(const CubeVertexes& cube, std::vector<size_t> vertex_indexes, const F& func) {
   // Get points
   size_t i1 = vertex_indexes[0];
   size_t i2 = vertex_indexes[1];
@@ -436,7 +449,8 @@ std::vector<Face3D> getFacesVertex3(const CubeVertexes& cube, std::vector<size_t
 }
 
 
-std::vector<Face3D> getFacesVertex4(const CubeVertexes& cube, std::vector<size_t> vertex_indexes, std::function<double(double, double, double)> func) {
+template <typename F>
+std::vector<Face3D> getFacesVertex4(const CubeVertexes& cube, std::vector<size_t> vertex_indexes, const F& func) {
   // How many neighbors has the least vertex not in the list
   size_t i1 = vertex_indexes[0];
   size_t i2 = vertex_indexes[1];
@@ -552,14 +566,27 @@ std::vector<Face3D> getFacesVertex4(const CubeVertexes& cube, std::vector<size_t
   }
   // CASE: Curved 
   else if (min_neighbors == 1 && max_neighbors == 2) {
-    // Make sure i1 and i4 have the most neighbors
+    // Make sure i1 and i4 have the most neighbors (the ends of the path)
     if (n1.size() != 2) {
-      std::swap(i1, i2);
-      std::swap(n1, n2);
+      if (n2.size() == 2) {
+        std::swap(i1, i2);
+        std::swap(n1, n2);
+      } else if (n3.size() == 2) {
+        std::swap(i1, i3);
+        std::swap(n1, n3);
+      } else {
+        std::swap(i1, i4);
+        std::swap(n1, n4);
+      }
     }
     if (n4.size() != 2) {
-      std::swap(i4, i3);
-      std::swap(n4, n3);
+      if (n2.size() == 2) {
+        std::swap(i4, i2);
+        std::swap(n4, n2);
+      } else {
+        std::swap(i4, i3);
+        std::swap(n4, n3);
+      }
     }
     // Make sure i2 is adjacent to i1
     if (!vertexAreAdjacent(i1, i2)) {
@@ -660,9 +687,13 @@ std::vector<Face3D> getFacesVertex4(const CubeVertexes& cube, std::vector<size_t
 
 
 
-std::vector<Face3D> cubeCases(
+// Faces of a cube from its corner colors: splits the colored corners in
+// connected groups and builds the faces of each group. Source of CUBE_CASES,
+// see printCubeTable
+template <typename F>
+std::vector<Face3D> resolveCubeCase(
   CubeVertexes cube,
-  std::function<double(double, double, double)> func
+  const F& func
 ) {
   CubeColors colors;
   // Get colors for each vertex
@@ -733,8 +764,288 @@ std::vector<Face3D> cubeCases(
 }
 
 
+// Index into CUBE_CASES: bit i is set when corner i is colored
+template <typename F>
+int getCubeCase(const CubeVertexes& cube, const F& func) {
+  int index = 0;
+  for (size_t i = 0; i < 8; i++) {
+    if (getColor(func, cube, i)) {
+      index |= 1 << i;
+    }
+  }
+  return index;
+}
+
+// Appends the faces of a cube: a table lookup and one interpolation per face vertex
+template <typename F>
+void cubeCases(
+  const CubeVertexes& cube,
+  const F& func,
+  std::vector<Face3D>& faces
+) {
+  const CubeCase& cube_case = CUBE_CASES[getCubeCase(cube, func)];
+  int point = 0;
+  for (int p = 0; p < cube_case.polygon_count; p++) {
+    Face3D face;
+    #ifdef DEBUG_COLOR
+    face.r = cube_case.colors[p][0];
+    face.g = cube_case.colors[p][1];
+    face.b = cube_case.colors[p][2];
+    #endif
+    face.vertices.resize(cube_case.sizes[p]);
+    for (auto& vertex : face.vertices) {
+      vertex = weightedMidpoint(cube[cube_case.points[point][0]], cube[cube_case.points[point][1]], func);
+      point++;
+    }
+    faces.push_back(std::move(face));
+  }
+}
+
+
+// Integer coordinates of a lattice point
+struct LatticePoint {
+  int i, j, k;
+};
+
+// Most halvings of the domain, so lattice coordinates fit in 21 bits
+const int MAX_LATTICE_DEPTH = 20;
+
+// Field values and edge crossings already computed on a FieldLattice, by
+// integer coordinates. Crossings have one map per axis, keyed by the lower end
+// of the edge
+struct LatticeCache {
+  std::unordered_map<std::uint64_t, double> values;
+  std::unordered_map<std::uint64_t, Vertex3D> crossings[3];
+};
+
+// Lattice of the leaf cubes over the domain. With a LatticeCache each lattice
+// point and each crossing is computed once however many cubes and levels
+// share it. Crossings are always interpolated from the lower end of the edge,
+// so both cubes of an edge (and any cache) get the same vertex
+template <typename F>
+class FieldLattice {
+private:
+  const F& func;
+  Vertex3D start;
+  Vertex3D spacing;
+
+  static std::uint64_t getKey(const LatticePoint& p) {
+    return ((std::uint64_t) p.i << 42) | ((std::uint64_t) p.j << 21) | (std::uint64_t) p.k;
+  }
+public:
+  FieldLattice(const F& func, const Vertex3D& start, const Vertex3D& end, int divisions) :
+    func(func), start(start), spacing((end - start) / (double) divisions) {}
+
+  const F& getFunction() const {
+    return func;
+  }
+
+  Vertex3D getPoint(const LatticePoint& p) const {
+    return Vertex3D(start.x + p.i * spacing.x, start.y + p.j * spacing.y, start.z + p.k * spacing.z);
+  }
+
+  double getValue(LatticeCache& cache, const LatticePoint& p) const {
+    auto inserted = cache.values.emplace(getKey(p), 0.0);
+    if (inserted.second) {
+      Vertex3D point = getPoint(p);
+      inserted.first->second = func(point.x, point.y, point.z);
+    }
+    return inserted.first->second;
+  }
+
+  // a and b differ by one along a single axis
+  Vertex3D getCrossing(LatticeCache& cache, LatticePoint a, LatticePoint b) const {
+    if (a.i + a.j + a.k > b.i + b.j + b.k) {
+      std::swap(a, b);
+    }
+    int axis = a.i != b.i ? 0 : (a.j != b.j ? 1 : 2);
+    auto inserted = cache.crossings[axis].emplace(getKey(a), Vertex3D());
+    if (inserted.second) {
+      inserted.first->second = weightedMidpoint(getPoint(a), getPoint(b), getValue(cache, a), getValue(cache, b));
+    }
+    return inserted.first->second;
+  }
+};
+
+// Corner c of the cube of size cells at p
+LatticePoint getCorner(const LatticePoint& p, int size, size_t c) {
+  Vertex3D offset = getVertex(c);
+  return LatticePoint{p.i + (int) offset.x * size, p.j + (int) offset.y * size, p.k + (int) offset.z * size};
+}
+
+// cubeCases over the leaf cube at p, with values and crossings from the lattice
+template <typename F>
+void cubeCases(const FieldLattice<F>& lattice, LatticeCache& cache, const LatticePoint& p, std::vector<Face3D>& faces) {
+  LatticePoint corners[8];
+  int index = 0;
+  for (size_t i = 0; i < 8; i++) {
+    corners[i] = getCorner(p, 1, i);
+    double value = lattice.getValue(cache, corners[i]);
+    // Corners exactly on the surface are resolved by getColor
+    bool colored = value > 0;
+    if (value == 0) {
+      CubeVertexes cube;
+      for (size_t c = 0; c < 8; c++) {
+        cube[c] = lattice.getPoint(getCorner(p, 1, c));
+      }
+      colored = getColor(lattice.getFunction(), cube, i);
+    }
+    if (colored) {
+      index |= 1 << i;
+    }
+  }
+  const CubeCase& cube_case = CUBE_CASES[index];
+  int point = 0;
+  for (int f = 0; f < cube_case.polygon_count; f++) {
+    Face3D face;
+    #ifdef DEBUG_COLOR
+    face.r = cube_case.colors[f][0];
+    face.g = cube_case.colors[f][1];
+    face.b = cube_case.colors[f][2];
+    #endif
+    face.vertices.resize(cube_case.sizes[f]);
+    for (auto& vertex : face.vertices) {
+      vertex = lattice.getCrossing(cache, corners[cube_case.points[point][0]], corners[cube_case.points[point][1]]);
+      point++;
+    }
+    faces.push_back(std::move(face));
+  }
+}
+
+// Octant 0 to 7 (ci * 4 + cj * 2 + ck) of the cube at p with halves of half cells
+LatticePoint getOctant(const LatticePoint& p, int half, int octant) {
+  return LatticePoint{p.i + (octant >> 2) * half, p.j + ((octant >> 1) & 1) * half, p.k + (octant & 1) * half};
+}
+
+// === Occupancy oracles ===
+// Decide whether a cube whose 8 corners have the same (non zero) sign may still
+// hold part of the surface, so it must be split. mayChangeSign gets the field,
+// the lower corner and the size of the cube and the values at its corners
+
+// Fields whose value changes by at most lipschitz per unit of distance: 1 for
+// signed distance fields and their unions, intersections and differences.
+// Every point of the cube is within half a diagonal of a corner, so the sign
+// cannot change when the smallest corner value is above lipschitz times that.
+// Never misses the surface and needs no field evaluations besides the corners
+struct LipschitzOracle {
+  double lipschitz = 1;
+
+  template <typename F>
+  bool mayChangeSign(const F&, const Vertex3D&, const Vertex3D& extent, const double values[8]) const {
+    double nearest = std::abs(values[0]);
+    for (size_t c = 1; c < 8; c++) {
+      nearest = std::min(nearest, std::abs(values[c]));
+    }
+    double diagonal = std::sqrt(extent.x * extent.x + extent.y * extent.y + extent.z * extent.z);
+    return nearest <= lipschitz * diagonal / 2.0;
+  }
+};
+
+// Any field: looks for a value of the other sign at the first samples points of
+// the R3 low discrepancy sequence, scaled to the cube. Can miss features
+// thinner than the sample spacing, but every run gives the same mesh
+struct SampledOracle {
+  size_t samples = 1000;
+
+  template <typename F>
+  bool mayChangeSign(const F& func, const Vertex3D& origin, const Vertex3D& extent, const double values[8]) const {
+    // Powers of 1 / 1.2207440846..., the root of x^4 = x + 1
+    const double a1 = 0.8191725133961644;
+    const double a2 = 0.6710436067037893;
+    const double a3 = 0.5497004779019701;
+    double u = 0.5, v = 0.5, w = 0.5;
+    bool positive = values[0] > 0;
+    for (size_t i = 0; i < samples; i++) {
+      u += a1;
+      v += a2;
+      w += a3;
+      u -= u >= 1 ? 1 : 0;
+      v -= v >= 1 ? 1 : 0;
+      w -= w >= 1 ? 1 : 0;
+      double value = func(origin.x + u * extent.x, origin.y + v * extent.y, origin.z + w * extent.z);
+      if (value == 0 || (value > 0) != positive) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+// Halves of the cube of size cells (a power of two) at p where the field
+// changes sign, judged from their corners and the oracle. Writes their octants
+// in serial order and returns how many there are
+template <typename F, typename O>
+int getSplitOctants(
+  const FieldLattice<F>& lattice,
+  LatticeCache& cache,
+  const LatticePoint& p,
+  int size,
+  const O& oracle,
+  int octants[8]
+) {
+  int half = size / 2;
+  Vertex3D extent = lattice.getPoint(LatticePoint{half, half, half}) - lattice.getPoint(LatticePoint{0, 0, 0});
+  int count = 0;
+  for (int octant = 0; octant < 8; octant++) {
+    LatticePoint child = getOctant(p, half, octant);
+    // Split as soon as two corners differ or one is on the surface
+    double values[8];
+    bool split = false;
+    for (size_t c = 0; c < 8 && !split; c++) {
+      values[c] = lattice.getValue(cache, getCorner(child, half, c));
+      split = values[c] == 0 || (c > 0 && (values[c] > 0) != (values[0] > 0));
+    }
+    if (!split) {
+      split = oracle.mayChangeSign(lattice.getFunction(), lattice.getPoint(child), extent, values);
+    }
+    if (split) {
+      octants[count++] = octant;
+    }
+  }
+  return count;
+}
+
+// Cube of size cells (a power of two) at p
+template <typename F, typename O>
+void adaptativeMarchingCubes(
+  const FieldLattice<F>& lattice,
+  LatticeCache& cache,
+  const LatticePoint& p,
+  int size,
+  const O& oracle,
+  std::vector<Face3D>& faces
+) {
+  if (size == 1) {
+    cubeCases(lattice, cache, p, faces);
+    return;
+  }
+  int octants[8];
+  int count = getSplitOctants(lattice, cache, p, size, oracle, octants);
+  for (int i = 0; i < count; i++) {
+    adaptativeMarchingCubes(lattice, cache, getOctant(p, size / 2, octants[i]), size / 2, oracle, faces);
+  }
+}
+
+// Halvings until width, height and depth are at most precision
+int getLatticeLevels(double width, double height, double depth, double precision) {
+  int levels = 0;
+  while ((width > precision || height > precision || depth > precision) && levels < MAX_LATTICE_DEPTH) {
+    width /= 2.0;
+    height /= 2.0;
+    depth /= 2.0;
+    levels++;
+  }
+  return levels;
+}
+
+// Faces of the zero set of func in the box, halving it until the cubes are at
+// most precision wide. Only cubes where the corners of the field change sign,
+// or the oracle finds it may, are split further. The default SampledOracle works
+// for any field but costs up to samples evaluations per cube; pass a
+// LipschitzOracle for distance fields to prune from the corners alone
+template <typename F, typename O = SampledOracle>
 std::vector<Face3D> adaptativeMarchingCubes(
-  std::function<double(double, double, double)> func,
+  const F& func,
   double x_start,
   double y_start,
   double z_start,
@@ -742,119 +1053,131 @@ std::vector<Face3D> adaptativeMarchingCubes(
   double y_end,
   double z_end,
   double precision,
-  size_t samples = 1000
+  const O& oracle = O()
 ) {
   // Return value
   std::vector<Face3D> faces;
-  auto width = x_end - x_start;
-  auto height = y_end - y_start;
-  auto depth = z_end - z_start;
-
-  // If width, height and depth are less than the precision, return the cube
-  if (width <= precision && height <= precision && depth <= precision) {
-    CubeVertexes cube = {
-      Vertex3D(x_start, y_start, z_start),
-      Vertex3D(x_end, y_start, z_start),
-      Vertex3D(x_end, y_end, z_start),
-      Vertex3D(x_start, y_end, z_start),
-      Vertex3D(x_start, y_start, z_end),
-      Vertex3D(x_end, y_start, z_end),
-      Vertex3D(x_end, y_end, z_end),
-      Vertex3D(x_start, y_end, z_end)
-    };    
-    return cubeCases(cube, func); 
-  }
-
-  // Split the space in cubes
-  double dx = width / 2.0;
-  double dy = height / 2.0;
-  double dz = depth / 2.0;
-
-  // Random sample generator
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_real_distribution<double> dis_x(0, dx);
-  std::uniform_real_distribution<double> dis_y(0, dy);
-  std::uniform_real_distribution<double> dis_z(0, dz);
-  // Sample squares
-  for (double x = x_start; x < x_end; x += dx) {
-    for (double y = y_start; y < y_end; y += dy) {
-      for (double z = z_start; z < z_end; z += dz) {
-        CubeVertexes cube = {
-          Vertex3D(x, y, z),
-          Vertex3D(x + dx, y, z),
-          Vertex3D(x + dx, y + dy, z),
-          Vertex3D(x, y + dy, z),
-          Vertex3D(x, y, z + dz),
-          Vertex3D(x + dx, y, z + dz),
-          Vertex3D(x + dx, y + dy, z + dz),
-          Vertex3D(x, y + dy, z + dz)
-        };
-        // Sample the cube
-        bool positive = false;
-        bool negative = false;
-        // Always sample the extremes for the key points
-        for (const Vertex3D& key_point : cube) {
-          double value = func(key_point.x, key_point.y, key_point.z);
-          double sign = getSign(value);
-          if (sign == 0) {
-            positive = true;
-            negative = true;
-            break;
-          } else if (sign > 0) {
-            positive = true;
-            if (negative) {break;} // Early exit
-          } else {
-            negative = true;
-            if (positive) {break;} // Early exit
-          }
-        }
-        // Random sample
-        for (size_t i = 0; i < samples; i++) {
-          double x_sample = x + dis_x(gen);
-          double y_sample = y + dis_y(gen);
-          double z_sample = z + dis_z(gen);
-          double value = func(x_sample, y_sample, z_sample);
-          double sign = getSign(value);
-          if (sign == 0) {
-            positive = true;
-            negative = true;
-            break;
-          } else if (sign > 0) {
-            positive = true;
-            if (negative) {break;} // Early exit
-          } else {
-            negative = true;
-            if (positive) {break;} // Early exit
-          }
-        }
-        // If different signs: Recurse
-        if (positive && negative) {
-          std::vector<Face3D> sub_faces = adaptativeMarchingCubes(
-            func, x, y, z, x + dx, y + dy, z + dz, precision, samples
-          );
-          for (const Face3D& face : sub_faces) {
-            faces.push_back(face);
-          }        
-        }
-      }
+  int levels = getLatticeLevels(x_end - x_start, y_end - y_start, z_end - z_start, precision);
+  FieldLattice<F> lattice(func, Vertex3D(x_start, y_start, z_start), Vertex3D(x_end, y_end, z_end), 1 << levels);
+  LatticeCache cache;
+  adaptativeMarchingCubes(lattice, cache, LatticePoint{0, 0, 0}, 1 << levels, oracle, faces);
+  return faces;
+}
+
+// === Parallel octree ===
+// Cubes above this depth split into one task per octant, deeper subtrees run
+// serially in one task
+const int PARALLEL_DEPTH = 3;
+
+// Faces and lattice cache of one thread. A task appends the faces of its
+// subtree as one segment, keyed by the octants on its path (base 8), which
+// sorts the segments in serial order
+struct MeshingArena {
+  struct Segment {
+    std::uint64_t path;
+    size_t begin, end;
+  };
+  LatticeCache cache;
+  std::vector<Face3D> faces;
+  std::vector<Segment> segments;
+};
+
+template <typename F, typename O>
+void parallelMarchingCubes(
+  TaskPool& pool,
+  const FieldLattice<F>& lattice,
+  std::vector<MeshingArena>& arenas,
+  const LatticePoint& p,
+  int size,
+  int depth,
+  std::uint64_t path,
+  const O& oracle
+) {
+  // Slot 0 is the thread waiting on the pool, which is not one of its workers
+  MeshingArena& arena = arenas[pool.current_worker() + 1];
+  if (size == 1 || depth == PARALLEL_DEPTH) {
+    size_t begin = arena.faces.size();
+    adaptativeMarchingCubes(lattice, arena.cache, p, size, oracle, arena.faces);
+    if (arena.faces.size() > begin) {
+      arena.segments.push_back(MeshingArena::Segment{path, begin, arena.faces.size()});
+    }
+    return;
+  }
+  int octants[8];
+  int count = getSplitOctants(lattice, arena.cache, p, size, oracle, octants);
+  for (int i = 0; i < count; i++) {
+    LatticePoint child = getOctant(p, size / 2, octants[i]);
+    std::uint64_t child_path = path * 8 + octants[i];
+    pool.submit([&pool, &lattice, &arenas, &oracle, child, size, depth, child_path]() {
+      parallelMarchingCubes(pool, lattice, arenas, child, size / 2, depth + 1, child_path, oracle);
+    });
+  }
+}
+
+// adaptativeMarchingCubes with the subtrees as tasks on pool. Each thread keeps
+// its own faces and cache, the faces are merged in serial order at the end.
+// Same oracle default as the serial version
+template <typename F, typename O = SampledOracle>
+std::vector<Face3D> adaptativeMarchingCubes(
+  TaskPool& pool,
+  const F& func,
+  double x_start,
+  double y_start,
+  double z_start,
+  double x_end,
+  double y_end,
+  double z_end,
+  double precision,
+  const O& oracle = O()
+) {
+  int levels = getLatticeLevels(x_end - x_start, y_end - y_start, z_end - z_start, precision);
+  FieldLattice<F> lattice(func, Vertex3D(x_start, y_start, z_start), Vertex3D(x_end, y_end, z_end), 1 << levels);
+  std::vector<MeshingArena> arenas(pool.get_thread_count() + 1);
+  pool.submit([&]() {
+    parallelMarchingCubes(pool, lattice, arenas, LatticePoint{0, 0, 0}, 1 << levels, 0, 0, oracle);
+  });
+  pool.wait();
+  // Merge
+  std::vector<std::pair<std::uint64_t, std::pair<int, int>>> order;
+  size_t face_count = 0;
+  for (size_t a = 0; a < arenas.size(); a++) {
+    for (size_t s = 0; s < arenas[a].segments.size(); s++) {
+      order.push_back({arenas[a].segments[s].path, {(int) a, (int) s}});
+      face_count += arenas[a].segments[s].end - arenas[a].segments[s].begin;
+    }
+  }
+  std::sort(order.begin(), order.end());
+  std::vector<Face3D> faces;
+  faces.reserve(face_count);
+  for (const auto& entry : order) {
+    MeshingArena& arena = arenas[entry.second.first];
+    const MeshingArena::Segment& segment = arena.segments[entry.second.second];
+    for (size_t f = segment.begin; f < segment.end; f++) {
+      faces.push_back(std::move(arena.faces[f]));
     }
   }
   return faces;
 }
 
+// Meshes f on a pool and writes it to filename. Uses SampledOracle unless
+// another oracle is given
+template <typename F, typename O = SampledOracle>
 void draw_mesh(
-  std::function<double(double, double, double)> f,
+  const F& f,
   const std::string& filename,
   double x_min, double y_min, double z_min,
   double x_max, double y_max, double z_max,
-  double precision
+  double precision,
+  const O& oracle = O()
 ) {
+  TaskPool pool;
   std::vector<Face3D> faces = adaptativeMarchingCubes(
+      pool,
       f,
       x_min, y_min, z_min,
       x_max, y_max, z_max,
-      precision
+      precision,
+      oracle
   );
   std::cout << "Faces: " << faces.size() << std::endl;
   // Create mesh
@@ -863,6 +1186,259 @@ void draw_mesh(
   mesh.save_ply(filename.c_str());
 }
 
+// Slope bound of getCylindersMinusSphere in [-10, 10]^3. Cylinders and sphere
+// are distance fields (1), the slab of getRectangleEquation is quadratic and
+// its slope reaches 26 along z at z = -10
+const double CYLINDERS_MINUS_SPHERE_LIPSCHITZ = 26;
+
+// Four cylinders joined by a slab, minus a sphere
+auto getCylindersMinusSphere() {
+  return CompositeFunctor3D(
+    CompositeFunctor3D(
+      CompositeFunctor3D(
+        CompositeFunctor3D(
+          getCylinderEquation(1, 4, -4, -4, 0),
+          getCylinderEquation(1, 4, 4, -4, 0),
+          OperationType::UNION
+        ),
+        CompositeFunctor3D(
+          getCylinderEquation(1, 4, -4, 4, 0),
+          getCylinderEquation(1, 4, 4, 4, 0),
+          OperationType::UNION
+        ),
+        OperationType::UNION
+      ),
+      // Rectangle from -5,-5,2 to 5,5,4
+      getRectangleEquation(-5, -5, 2, 5, 5, 4),
+      OperationType::UNION
+    ),
+    // Sphere at 0,0,3 with radius 2
+    getSphereEquation(2, 0, 0, 3),
+    OperationType::SUBSTRACT
+  );
+}
+
+// === Case table generation ===
+// Built with -DCUBE_TABLE_TOOL (make marching_cubes_table). Runs resolveCubeCase
+// on the unit cube for every case, prints CUBE_CASES to stdout and checks the
+// compiled table against resolveCubeCase on cubes with random corner values
+
+// Corner values of the unit cube: +-1 by case, scaled by magnitudes
+auto getUnitCubeField(int index, const std::array<double, 8>& magnitudes) {
+  return [index, magnitudes](double x, double y, double z) {
+    for (size_t i = 0; i < 8; i++) {
+      Vertex3D corner = getVertex(i);
+      if (corner.x == x && corner.y == y && corner.z == z) {
+        return index & (1 << i) ? magnitudes[i] : -magnitudes[i];
+      }
+    }
+    std::cerr << "Not a corner: " << x << " " << y << " " << z << std::endl;
+    return 1.0;
+  };
+}
+
+CubeVertexes getUnitCube() {
+  CubeVertexes cube;
+  for (size_t i = 0; i < 8; i++) {
+    cube[i] = getVertex(i);
+  }
+  return cube;
+}
+
+void printCubeTable() {
+  CubeVertexes cube = getUnitCube();
+  std::array<double, 8> ones = {1, 1, 1, 1, 1, 1, 1, 1};
+  std::cout << "// Generated by `make marching_cubes_table` from resolveCubeCase in MarchingCubes.cpp" << std::endl;
+  std::cout << "#include <cstdint>" << std::endl << std::endl;
+  std::cout << "#ifndef MARCHING_CUBES_TABLE_H" << std::endl;
+  std::cout << "#define MARCHING_CUBES_TABLE_H" << std::endl << std::endl;
+  std::cout << "const int CUBE_CASE_MAX_POLYGONS = 4;" << std::endl;
+  std::cout << "const int CUBE_CASE_MAX_POINTS = 12;" << std::endl << std::endl;
+  std::cout << "// Faces of a cube for one of the 256 colorings of its corners (bit i set when" << std::endl;
+  std::cout << "// corner i is colored). Face vertices are the crossings along corner pairs," << std::endl;
+  std::cout << "// interpolated from points[v][0] to points[v][1], already oriented" << std::endl;
+  std::cout << "struct CubeCase {" << std::endl;
+  std::cout << "  std::uint8_t polygon_count;" << std::endl;
+  std::cout << "  std::uint8_t sizes[CUBE_CASE_MAX_POLYGONS];" << std::endl;
+  std::cout << "  std::uint8_t colors[CUBE_CASE_MAX_POLYGONS][3];" << std::endl;
+  std::cout << "  std::uint8_t points[CUBE_CASE_MAX_POINTS][2];" << std::endl;
+  std::cout << "};" << std::endl << std::endl;
+  std::cout << "constexpr CubeCase CUBE_CASES[256] = {" << std::endl;
+  for (int index = 0; index < 256; index++) {
+    std::vector<Face3D> faces = resolveCubeCase(cube, getUnitCubeField(index, ones));
+    // Crossings start at the colored corner, or at the uncolored one when the
+    // case has more than 4 colored corners and was flipped
+    int colored = 0;
+    for (size_t i = 0; i < 8; i++) {
+      colored += index & (1 << i) ? 1 : 0;
+    }
+    bool from_colored = colored <= 4;
+    std::string sizes, colors, points;
+    int point_count = 0;
+    for (const Face3D& face : faces) {
+      sizes += (sizes.empty() ? "" : ", ") + std::to_string(face.vertices.size());
+      colors += std::string(colors.empty() ? "" : ", ") + "{" + std::to_string(face.r) + ", " + std::to_string(face.g) + ", " + std::to_string(face.b) + "}";
+      for (const Vertex3D& vertex : face.vertices) {
+        // Every crossing is the midpoint of its corner pair
+        for (size_t a = 0; a < 8; a++) {
+          bool a_colored = index & (1 << a);
+          if (a_colored != from_colored) {
+            continue;
+          }
+          for (size_t b : getVertexNeighbors(a)) {
+            Vertex3D midpoint = (getVertex(a) + getVertex(b)) / 2.0;
+            bool b_colored = index & (1 << b);
+            if (b_colored != from_colored && midpoint.x == vertex.x && midpoint.y == vertex.y && midpoint.z == vertex.z) {
+              points += std::string(points.empty() ? "" : ", ") + "{" + std::to_string(a) + ", " + std::to_string(b) + "}";
+              point_count++;
+            }
+          }
+        }
+      }
+    }
+    // Each face vertex must be on exactly one edge with a sign change
+    int vertex_count = 0;
+    for (const Face3D& face : faces) {
+      vertex_count += face.vertices.size();
+    }
+    if (point_count != vertex_count) {
+      std::cerr << "Case " << index << " has vertices off the crossing edges" << std::endl;
+    }
+    if (faces.size() > 4 || point_count > 12) {
+      std::cerr << "Case " << index << " does not fit in CubeCase" << std::endl;
+    }
+    std::cout << "  {" << faces.size() << ", {" << sizes << "}, {" << colors << "}, {" << points << "}}, // " << index << std::endl;
+  }
+  std::cout << "};" << std::endl << std::endl;
+  std::cout << "#endif" << std::endl;
+}
+
+bool sameVertices(const std::vector<Vertex3D>& a, const std::vector<Vertex3D>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].x != b[i].x || a[i].y != b[i].y || a[i].z != b[i].z) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compares the faces of cubeCases and resolveCubeCase vertex by vertex.
+// Returns the cubes with different faces. Faces equal up to their order are
+// counted in reversed: resolveCubeCase orients the non planar quad of the 4
+// corner path cases from its first three vertices, which can flip with skewed
+// crossings, while the table keeps the orientation of the centered crossings
+int verifyCubeTable(int rounds, int& reversed) {
+  CubeVertexes cube = getUnitCube();
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dis(0.01, 10);
+  int mismatches = 0;
+  reversed = 0;
+  for (int index = 0; index < 256; index++) {
+    for (int round = 0; round < rounds; round++) {
+      std::array<double, 8> magnitudes;
+      for (double& magnitude : magnitudes) {
+        magnitude = round == 0 ? 1 : dis(gen);
+      }
+      auto field = getUnitCubeField(index, magnitudes);
+      std::vector<Face3D> expected = resolveCubeCase(cube, field);
+      std::vector<Face3D> faces;
+      cubeCases(cube, field, faces);
+      bool same = faces.size() == expected.size();
+      for (size_t f = 0; same && f < faces.size(); f++) {
+        same = faces[f].r == expected[f].r && faces[f].g == expected[f].g && faces[f].b == expected[f].b;
+        if (same && !sameVertices(faces[f].vertices, expected[f].vertices)) {
+          expected[f].flip();
+          same = sameVertices(faces[f].vertices, expected[f].vertices);
+          reversed += same ? 1 : 0;
+        }
+      }
+      if (!same) {
+        mismatches++;
+      }
+    }
+  }
+  return mismatches;
+}
+
+// === Benchmark ===
+// Built with -DMARCHING_CUBES_BENCH (make bench_marching_cubes). Meshes the scene
+// of main with the field behind a std::function, like every call took it before
+// the mesher was templated, and with its own type, which inlines into the mesher
+
+// Best of runs of mesher
+template <typename M>
+double timeMarchingCubes(const M& mesher, int runs, size_t& face_count) {
+  double best = 0;
+  for (int run = 0; run < runs; run++) {
+    auto start = std::chrono::steady_clock::now();
+    face_count = mesher().size();
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    best = run == 0 ? ms : std::min(best, ms);
+  }
+  return best;
+}
+
+#ifdef CUBE_TABLE_TOOL
+int main() {
+  int rounds = 1000;
+  int reversed;
+  int mismatches = verifyCubeTable(rounds, reversed);
+  std::cerr << "Compiled table: " << mismatches << " mismatches and " << reversed << " reversed faces in " << 256 * rounds << " cubes" << std::endl;
+  printCubeTable();
+  return 0;
+}
+#elif defined(MARCHING_CUBES_BENCH)
+int main() {
+  auto scene = getCylindersMinusSphere();
+  std::function<double(double, double, double)> erased = scene;
+  int runs = 5;
+  size_t erased_faces, inlined_faces;
+  double erased_ms = timeMarchingCubes([&]() {
+    return adaptativeMarchingCubes(erased, -10, -10, -10, 10, 10, 10, 1);
+  }, runs, erased_faces);
+  double inlined_ms = timeMarchingCubes([&]() {
+    return adaptativeMarchingCubes(scene, -10, -10, -10, 10, 10, 10, 1);
+  }, runs, inlined_faces);
+  std::cout << "Cylinders minus sphere, precision 1, best of " << runs << std::endl;
+  std::cout << "  std::function: " << erased_ms << " ms (" << erased_faces << " faces)" << std::endl;
+  std::cout << "  templated: " << inlined_ms << " ms (" << inlined_faces << " faces)" << std::endl;
+  std::cout << "  speedup: " << erased_ms / inlined_ms << "x" << std::endl;
+  // Occupancy oracles
+  for (double precision : {1.0, 0.25}) {
+    size_t sampled_faces, lipschitz_faces;
+    double sampled_ms = timeMarchingCubes([&]() {
+      return adaptativeMarchingCubes(scene, -10, -10, -10, 10, 10, 10, precision, SampledOracle{});
+    }, runs, sampled_faces);
+    double lipschitz_ms = timeMarchingCubes([&]() {
+      return adaptativeMarchingCubes(scene, -10, -10, -10, 10, 10, 10, precision, LipschitzOracle{CYLINDERS_MINUS_SPHERE_LIPSCHITZ});
+    }, runs, lipschitz_faces);
+    std::cout << "Occupancy oracles, precision " << precision << ", best of " << runs << std::endl;
+    std::cout << "  sampled (1000): " << sampled_ms << " ms (" << sampled_faces << " faces)" << std::endl;
+    std::cout << "  lipschitz: " << lipschitz_ms << " ms (" << lipschitz_faces << " faces)" << std::endl;
+    std::cout << "  speedup: " << sampled_ms / lipschitz_ms << "x" << std::endl;
+  }
+  // Parallel octree at finer precision with the sampled oracle, doubling the
+  // threads up to the hardware
+  double precision = 0.5;
+  int hardware = std::max(1u, std::thread::hardware_concurrency());
+  std::cout << "Parallel octree, precision " << precision << ", best of " << runs << std::endl;
+  double serial_ms = 0;
+  for (int threads = 1; threads <= hardware; threads = threads == hardware ? hardware + 1 : std::min(threads * 2, hardware)) {
+    TaskPool pool(threads);
+    size_t faces;
+    double ms = timeMarchingCubes([&]() {
+      return adaptativeMarchingCubes(pool, scene, -10, -10, -10, 10, 10, 10, precision);
+    }, runs, faces);
+    serial_ms = threads == 1 ? ms : serial_ms;
+    std::cout << "  " << threads << " threads: " << ms << " ms (" << faces << " faces), speedup " << serial_ms / ms << "x" << std::endl;
+  }
+  return 0;
+}
+#else
 int main() {
   /*draw_mesh(
     f,
@@ -874,34 +1450,14 @@ int main() {
     0.125
   );*/
   draw_mesh(
-    CompositeFunctor3D(
-      CompositeFunctor3D(
-        CompositeFunctor3D(
-          CompositeFunctor3D(
-            getCylinderEquation(1, 4, -4, -4, 0),
-            getCylinderEquation(1, 4, 4, -4, 0),
-            OperationType::UNION
-          ),
-          CompositeFunctor3D(
-            getCylinderEquation(1, 4, -4, 4, 0),
-            getCylinderEquation(1, 4, 4, 4, 0),
-            OperationType::UNION
-          ),
-          OperationType::UNION
-        ),
-        // Rectangle from -5,-5,2 to 5,5,4
-        getRectangleEquation(-5, -5, 2, 5, 5, 4),
-        OperationType::UNION
-      ),
-      // Sphere at 0,0,3 with radius 2
-      getSphereEquation(2, 0, 0, 3),
-      OperationType::SUBSTRACT
-    ),
+    getCylindersMinusSphere(),
     //getCylinderEquation(1, 2, -4, 0, -4),
     "outputs/out.ply",
     -10,-10,-10,
     10,10,10,
-    1
+    1,
+    LipschitzOracle{CYLINDERS_MINUS_SPHERE_LIPSCHITZ}
   );
   return 0;
 }
+#endif
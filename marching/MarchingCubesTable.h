@@ -0,0 +1,279 @@
+// Generated by `make marching_cubes_table` from resolveCubeCase in MarchingCubes.cpp
+#include <cstdint>
+
+#ifndef MARCHING_CUBES_TABLE_H
+#define MARCHING_CUBES_TABLE_H
+
+const int CUBE_CASE_MAX_POLYGONS = 4;
+const int CUBE_CASE_MAX_POINTS = 12;
+
+// Faces of a cube for one of the 256 colorings of its corners (bit i set when
+// corner i is colored). Face vertices are the crossings along corner pairs,
+// interpolated from points[v][0] to points[v][1], already oriented
+struct CubeCase {
+  std::uint8_t polygon_count;
+  std::uint8_t sizes[CUBE_CASE_MAX_POLYGONS];
+  std::uint8_t colors[CUBE_CASE_MAX_POLYGONS][3];
+  std::uint8_t points[CUBE_CASE_MAX_POINTS][2];
+};
+
+constexpr CubeCase CUBE_CASES[256] = {
+  {0, {}, {}, {}}, // 0
+  {1, {3}, {{255, 0, 0}}, {{0, 4}, {0, 3}, {0, 1}}}, // 1
+  {1, {3}, {{255, 0, 0}}, {{1, 0}, {1, 2}, {1, 5}}}, // 2
+  {1, {4}, {{0, 255, 0}}, {{1, 2}, {1, 5}, {0, 4}, {0, 3}}}, // 3
+  {1, {3}, {{255, 0, 0}}, {{2, 1}, {2, 3}, {2, 6}}}, // 4
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{0, 4}, {0, 3}, {0, 1}, {2, 1}, {2, 3}, {2, 6}}}, // 5
+  {1, {4}, {{0, 255, 0}}, {{2, 3}, {2, 6}, {1, 5}, {1, 0}}}, // 6
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{1, 5}, {0, 4}, {2, 6}, {0, 4}, {0, 3}, {2, 3}, {2, 6}}}, // 7
+  {1, {3}, {{255, 0, 0}}, {{3, 7}, {3, 2}, {3, 0}}}, // 8
+  {1, {4}, {{0, 255, 0}}, {{0, 1}, {0, 4}, {3, 7}, {3, 2}}}, // 9
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{1, 0}, {1, 2}, {1, 5}, {3, 7}, {3, 2}, {3, 0}}}, // 10
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{0, 4}, {3, 7}, {1, 5}, {3, 7}, {3, 2}, {1, 2}, {1, 5}}}, // 11
+  {1, {4}, {{0, 255, 0}}, {{3, 0}, {3, 7}, {2, 6}, {2, 1}}}, // 12
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{2, 6}, {0, 4}, {3, 7}, {2, 6}, {2, 1}, {0, 1}, {0, 4}}}, // 13
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{2, 6}, {1, 5}, {3, 7}, {1, 5}, {1, 0}, {3, 0}, {3, 7}}}, // 14
+  {1, {4}, {{255, 255, 0}}, {{0, 4}, {3, 7}, {2, 6}, {1, 5}}}, // 15
+  {1, {3}, {{255, 0, 0}}, {{4, 0}, {4, 5}, {4, 7}}}, // 16
+  {1, {4}, {{0, 255, 0}}, {{4, 5}, {4, 7}, {0, 3}, {0, 1}}}, // 17
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{1, 0}, {1, 2}, {1, 5}, {4, 0}, {4, 5}, {4, 7}}}, // 18
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{1, 2}, {4, 7}, {0, 3}, {1, 2}, {1, 5}, {4, 5}, {4, 7}}}, // 19
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{2, 1}, {2, 3}, {2, 6}, {4, 0}, {4, 5}, {4, 7}}}, // 20
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{4, 5}, {4, 7}, {0, 3}, {0, 1}, {2, 1}, {2, 3}, {2, 6}}}, // 21
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{2, 3}, {2, 6}, {1, 5}, {1, 0}, {4, 0}, {4, 5}, {4, 7}}}, // 22
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{4, 7}, {0, 3}, {4, 5}, {0, 3}, {2, 3}, {2, 6}, {4, 5}, {2, 6}, {1, 5}, {4, 5}}}, // 23
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{3, 7}, {3, 2}, {3, 0}, {4, 0}, {4, 5}, {4, 7}}}, // 24
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{0, 1}, {4, 5}, {3, 2}, {4, 5}, {4, 7}, {3, 7}, {3, 2}}}, // 25
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{1, 0}, {1, 2}, {1, 5}, {3, 7}, {3, 2}, {3, 0}, {4, 0}, {4, 5}, {4, 7}}}, // 26
+  {1, {6}, {{128, 0, 128}}, {{4, 5}, {4, 7}, {3, 7}, {3, 2}, {1, 2}, {1, 5}}}, // 27
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{3, 0}, {3, 7}, {2, 6}, {2, 1}, {4, 0}, {4, 5}, {4, 7}}}, // 28
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{4, 7}, {0, 1}, {4, 5}, {4, 7}, {2, 6}, {2, 1}, {0, 1}, {4, 7}, {3, 7}, {2, 6}}}, // 29
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{2, 6}, {1, 5}, {3, 7}, {1, 5}, {1, 0}, {3, 0}, {3, 7}, {4, 0}, {4, 5}, {4, 7}}}, // 30
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{6, 2}, {5, 1}, {7, 3}, {5, 1}, {5, 4}, {7, 4}, {7, 3}}}, // 31
+  {1, {3}, {{255, 0, 0}}, {{5, 6}, {5, 4}, {5, 1}}}, // 32
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{0, 4}, {0, 3}, {0, 1}, {5, 6}, {5, 4}, {5, 1}}}, // 33
+  {1, {4}, {{0, 255, 0}}, {{1, 0}, {1, 2}, {5, 6}, {5, 4}}}, // 34
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{5, 6}, {0, 3}, {1, 2}, {5, 6}, {5, 4}, {0, 4}, {0, 3}}}, // 35
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{2, 1}, {2, 3}, {2, 6}, {5, 6}, {5, 4}, {5, 1}}}, // 36
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{0, 4}, {0, 3}, {0, 1}, {2, 1}, {2, 3}, {2, 6}, {5, 6}, {5, 4}, {5, 1}}}, // 37
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{2, 3}, {5, 4}, {1, 0}, {2, 3}, {2, 6}, {5, 6}, {5, 4}}}, // 38
+  {1, {6}, {{128, 0, 128}}, {{2, 3}, {2, 6}, {5, 6}, {5, 4}, {0, 4}, {0, 3}}}, // 39
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{3, 7}, {3, 2}, {3, 0}, {5, 6}, {5, 4}, {5, 1}}}, // 40
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{0, 1}, {0, 4}, {3, 7}, {3, 2}, {5, 6}, {5, 4}, {5, 1}}}, // 41
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{1, 0}, {1, 2}, {5, 6}, {5, 4}, {3, 7}, {3, 2}, {3, 0}}}, // 42
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{3, 2}, {0, 4}, {3, 7}, {3, 2}, {5, 6}, {5, 4}, {0, 4}, {3, 2}, {1, 2}, {5, 6}}}, // 43
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{3, 0}, {3, 7}, {2, 6}, {2, 1}, {5, 6}, {5, 4}, {5, 1}}}, // 44
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{2, 6}, {0, 4}, {3, 7}, {2, 6}, {2, 1}, {0, 1}, {0, 4}, {5, 6}, {5, 4}, {5, 1}}}, // 45
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{5, 4}, {1, 0}, {5, 6}, {1, 0}, {3, 0}, {3, 7}, {5, 6}, {3, 7}, {2, 6}, {5, 6}}}, // 46
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{6, 2}, {4, 0}, {7, 3}, {6, 2}, {6, 5}, {4, 5}, {4, 0}}}, // 47
+  {1, {4}, {{0, 255, 0}}, {{5, 1}, {5, 6}, {4, 7}, {4, 0}}}, // 48
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{4, 7}, {0, 3}, {5, 6}, {0, 3}, {0, 1}, {5, 1}, {5, 6}}}, // 49
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{4, 7}, {1, 2}, {5, 6}, {4, 7}, {4, 0}, {1, 0}, {1, 2}}}, // 50
+  {1, {4}, {{255, 255, 0}}, {{1, 2}, {5, 6}, {4, 7}, {0, 3}}}, // 51
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{2, 1}, {2, 3}, {2, 6}, {5, 1}, {5, 6}, {4, 7}, {4, 0}}}, // 52
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{4, 7}, {0, 3}, {5, 6}, {0, 3}, {0, 1}, {5, 1}, {5, 6}, {2, 1}, {2, 3}, {2, 6}}}, // 53
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{4, 0}, {5, 6}, {4, 7}, {4, 0}, {2, 3}, {2, 6}, {5, 6}, {4, 0}, {1, 0}, {2, 3}}}, // 54
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{7, 4}, {3, 0}, {6, 5}, {3, 0}, {3, 2}, {6, 2}, {6, 5}}}, // 55
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{3, 7}, {3, 2}, {3, 0}, {5, 1}, {5, 6}, {4, 7}, {4, 0}}}, // 56
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{5, 6}, {4, 7}, {5, 1}, {4, 7}, {3, 7}, {3, 2}, {5, 1}, {3, 2}, {0, 1}, {5, 1}}}, // 57
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{4, 7}, {1, 2}, {5, 6}, {4, 7}, {4, 0}, {1, 0}, {1, 2}, {3, 7}, {3, 2}, {3, 0}}}, // 58
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{7, 4}, {2, 1}, {6, 5}, {7, 4}, {7, 3}, {2, 3}, {2, 1}}}, // 59
+  {2, {4, 4}, {{0, 255, 0}, {0, 255, 0}}, {{3, 0}, {3, 7}, {2, 6}, {2, 1}, {5, 1}, {5, 6}, {4, 7}, {4, 0}}}, // 60
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{1, 5}, {1, 2}, {1, 0}, {6, 2}, {6, 5}, {7, 4}, {7, 3}}}, // 61
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{0, 1}, {0, 3}, {0, 4}, {6, 2}, {6, 5}, {7, 4}, {7, 3}}}, // 62
+  {1, {4}, {{0, 255, 0}}, {{6, 2}, {6, 5}, {7, 4}, {7, 3}}}, // 63
+  {1, {3}, {{255, 0, 0}}, {{6, 7}, {6, 5}, {6, 2}}}, // 64
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{0, 4}, {0, 3}, {0, 1}, {6, 7}, {6, 5}, {6, 2}}}, // 65
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{1, 0}, {1, 2}, {1, 5}, {6, 7}, {6, 5}, {6, 2}}}, // 66
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{1, 2}, {1, 5}, {0, 4}, {0, 3}, {6, 7}, {6, 5}, {6, 2}}}, // 67
+  {1, {4}, {{0, 255, 0}}, {{2, 1}, {2, 3}, {6, 7}, {6, 5}}}, // 68
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{0, 4}, {0, 3}, {0, 1}, {2, 1}, {2, 3}, {6, 7}, {6, 5}}}, // 69
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{6, 7}, {1, 0}, {2, 3}, {6, 7}, {6, 5}, {1, 5}, {1, 0}}}, // 70
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{0, 3}, {1, 5}, {0, 4}, {0, 3}, {6, 7}, {6, 5}, {1, 5}, {0, 3}, {2, 3}, {6, 7}}}, // 71
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{3, 7}, {3, 2}, {3, 0}, {6, 7}, {6, 5}, {6, 2}}}, // 72
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{0, 1}, {0, 4}, {3, 7}, {3, 2}, {6, 7}, {6, 5}, {6, 2}}}, // 73
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{1, 0}, {1, 2}, {1, 5}, {3, 7}, {3, 2}, {3, 0}, {6, 7}, {6, 5}, {6, 2}}}, // 74
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{0, 4}, {3, 7}, {1, 5}, {3, 7}, {3, 2}, {1, 2}, {1, 5}, {6, 7}, {6, 5}, {6, 2}}}, // 75
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{3, 0}, {6, 5}, {2, 1}, {3, 0}, {3, 7}, {6, 7}, {6, 5}}}, // 76
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{0, 4}, {3, 7}, {0, 1}, {3, 7}, {6, 7}, {6, 5}, {0, 1}, {6, 5}, {2, 1}, {0, 1}}}, // 77
+  {1, {6}, {{128, 0, 128}}, {{3, 0}, {3, 7}, {6, 7}, {6, 5}, {1, 5}, {1, 0}}}, // 78
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{4, 0}, {7, 3}, {5, 1}, {7, 3}, {7, 6}, {5, 6}, {5, 1}}}, // 79
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{4, 0}, {4, 5}, {4, 7}, {6, 7}, {6, 5}, {6, 2}}}, // 80
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{4, 5}, {4, 7}, {0, 3}, {0, 1}, {6, 7}, {6, 5}, {6, 2}}}, // 81
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{1, 0}, {1, 2}, {1, 5}, {4, 0}, {4, 5}, {4, 7}, {6, 7}, {6, 5}, {6, 2}}}, // 82
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{1, 2}, {4, 7}, {0, 3}, {1, 2}, {1, 5}, {4, 5}, {4, 7}, {6, 7}, {6, 5}, {6, 2}}}, // 83
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{2, 1}, {2, 3}, {6, 7}, {6, 5}, {4, 0}, {4, 5}, {4, 7}}}, // 84
+  {2, {4, 4}, {{0, 255, 0}, {0, 255, 0}}, {{4, 5}, {4, 7}, {0, 3}, {0, 1}, {2, 1}, {2, 3}, {6, 7}, {6, 5}}}, // 85
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{6, 7}, {1, 0}, {2, 3}, {6, 7}, {6, 5}, {1, 5}, {1, 0}, {4, 0}, {4, 5}, {4, 7}}}, // 86
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{3, 0}, {3, 2}, {7, 6}, {7, 4}, {5, 1}, {5, 4}, {5, 6}}}, // 87
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{3, 7}, {3, 2}, {3, 0}, {4, 0}, {4, 5}, {4, 7}, {6, 7}, {6, 5}, {6, 2}}}, // 88
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{0, 1}, {4, 5}, {3, 2}, {4, 5}, {4, 7}, {3, 7}, {3, 2}, {6, 7}, {6, 5}, {6, 2}}}, // 89
+  {4, {3, 3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{1, 0}, {1, 2}, {1, 5}, {3, 7}, {3, 2}, {3, 0}, {4, 0}, {4, 5}, {4, 7}, {6, 7}, {6, 5}, {6, 2}}}, // 90
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{2, 6}, {2, 3}, {2, 1}, {5, 1}, {5, 4}, {5, 6}, {7, 6}, {7, 4}, {7, 3}}}, // 91
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{3, 0}, {6, 5}, {2, 1}, {3, 0}, {3, 7}, {6, 7}, {6, 5}, {4, 0}, {4, 5}, {4, 7}}}, // 92
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{5, 4}, {5, 6}, {1, 2}, {1, 0}, {7, 6}, {7, 4}, {7, 3}}}, // 93
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{0, 1}, {0, 3}, {0, 4}, {5, 1}, {5, 4}, {5, 6}, {7, 6}, {7, 4}, {7, 3}}}, // 94
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{5, 1}, {5, 4}, {5, 6}, {7, 6}, {7, 4}, {7, 3}}}, // 95
+  {1, {4}, {{0, 255, 0}}, {{6, 2}, {6, 7}, {5, 4}, {5, 1}}}, // 96
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{0, 4}, {0, 3}, {0, 1}, {6, 2}, {6, 7}, {5, 4}, {5, 1}}}, // 97
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{5, 4}, {1, 0}, {6, 7}, {1, 0}, {1, 2}, {6, 2}, {6, 7}}}, // 98
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{0, 3}, {1, 2}, {0, 4}, {1, 2}, {6, 2}, {6, 7}, {0, 4}, {6, 7}, {5, 4}, {0, 4}}}, // 99
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{5, 4}, {2, 3}, {6, 7}, {5, 4}, {5, 1}, {2, 1}, {2, 3}}}, // 100
+  {3, {3, 3, 4}, {{255, 0, 0}, {0, 0, 255}, {0, 0, 255}}, {{0, 4}, {0, 3}, {0, 1}, {5, 4}, {2, 3}, {6, 7}, {5, 4}, {5, 1}, {2, 1}, {2, 3}}}, // 101
+  {1, {4}, {{255, 255, 0}}, {{2, 3}, {6, 7}, {5, 4}, {1, 0}}}, // 102
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{4, 5}, {3, 2}, {7, 6}, {4, 5}, {4, 0}, {3, 0}, {3, 2}}}, // 103
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{3, 7}, {3, 2}, {3, 0}, {6, 2}, {6, 7}, {5, 4}, {5, 1}}}, // 104
+  {2, {4, 4}, {{0, 255, 0}, {0, 255, 0}}, {{0, 1}, {0, 4}, {3, 7}, {3, 2}, {6, 2}, {6, 7}, {5, 4}, {5, 1}}}, // 105
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{5, 4}, {1, 0}, {6, 7}, {1, 0}, {1, 2}, {6, 2}, {6, 7}, {3, 7}, {3, 2}, {3, 0}}}, // 106
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{2, 6}, {2, 3}, {2, 1}, {7, 3}, {7, 6}, {4, 5}, {4, 0}}}, // 107
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{5, 1}, {6, 7}, {5, 4}, {5, 1}, {3, 0}, {3, 7}, {6, 7}, {5, 1}, {2, 1}, {3, 0}}}, // 108
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{1, 5}, {1, 2}, {1, 0}, {7, 3}, {7, 6}, {4, 5}, {4, 0}}}, // 109
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{4, 5}, {0, 1}, {7, 6}, {0, 1}, {0, 3}, {7, 3}, {7, 6}}}, // 110
+  {1, {4}, {{0, 255, 0}}, {{7, 3}, {7, 6}, {4, 5}, {4, 0}}}, // 111
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{6, 2}, {4, 0}, {5, 1}, {6, 2}, {6, 7}, {4, 7}, {4, 0}}}, // 112
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{0, 1}, {4, 7}, {0, 3}, {0, 1}, {6, 2}, {6, 7}, {4, 7}, {0, 1}, {5, 1}, {6, 2}}}, // 113
+  {1, {6}, {{128, 0, 128}}, {{1, 0}, {1, 2}, {6, 2}, {6, 7}, {4, 7}, {4, 0}}}, // 114
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{3, 0}, {2, 1}, {7, 4}, {2, 1}, {2, 6}, {7, 6}, {7, 4}}}, // 115
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{2, 3}, {6, 7}, {2, 1}, {6, 7}, {4, 7}, {4, 0}, {2, 1}, {4, 0}, {5, 1}, {2, 1}}}, // 116
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{1, 5}, {1, 2}, {1, 0}, {3, 0}, {3, 2}, {7, 6}, {7, 4}}}, // 117
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{7, 6}, {0, 1}, {3, 2}, {7, 6}, {7, 4}, {0, 4}, {0, 1}}}, // 118
+  {1, {4}, {{0, 255, 0}}, {{3, 0}, {3, 2}, {7, 6}, {7, 4}}}, // 119
+  {3, {3, 3, 4}, {{255, 0, 0}, {0, 0, 255}, {0, 0, 255}}, {{3, 7}, {3, 2}, {3, 0}, {6, 2}, {4, 0}, {5, 1}, {6, 2}, {6, 7}, {4, 7}, {4, 0}}}, // 120
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{1, 0}, {1, 5}, {2, 6}, {2, 3}, {7, 6}, {7, 4}, {7, 3}}}, // 121
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{0, 1}, {0, 3}, {0, 4}, {2, 6}, {2, 3}, {2, 1}, {7, 6}, {7, 4}, {7, 3}}}, // 122
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{2, 6}, {2, 3}, {2, 1}, {7, 6}, {7, 4}, {7, 3}}}, // 123
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{0, 3}, {0, 4}, {1, 5}, {1, 2}, {7, 6}, {7, 4}, {7, 3}}}, // 124
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{1, 5}, {1, 2}, {1, 0}, {7, 6}, {7, 4}, {7, 3}}}, // 125
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{0, 1}, {0, 3}, {0, 4}, {7, 6}, {7, 4}, {7, 3}}}, // 126
+  {1, {3}, {{255, 0, 0}}, {{7, 6}, {7, 4}, {7, 3}}}, // 127
+  {1, {3}, {{255, 0, 0}}, {{7, 3}, {7, 4}, {7, 6}}}, // 128
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{0, 4}, {0, 3}, {0, 1}, {7, 3}, {7, 4}, {7, 6}}}, // 129
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{1, 0}, {1, 2}, {1, 5}, {7, 3}, {7, 4}, {7, 6}}}, // 130
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{1, 2}, {1, 5}, {0, 4}, {0, 3}, {7, 3}, {7, 4}, {7, 6}}}, // 131
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{2, 1}, {2, 3}, {2, 6}, {7, 3}, {7, 4}, {7, 6}}}, // 132
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{0, 4}, {0, 3}, {0, 1}, {2, 1}, {2, 3}, {2, 6}, {7, 3}, {7, 4}, {7, 6}}}, // 133
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{2, 3}, {2, 6}, {1, 5}, {1, 0}, {7, 3}, {7, 4}, {7, 6}}}, // 134
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{1, 5}, {0, 4}, {2, 6}, {0, 4}, {0, 3}, {2, 3}, {2, 6}, {7, 3}, {7, 4}, {7, 6}}}, // 135
+  {1, {4}, {{0, 255, 0}}, {{7, 4}, {7, 6}, {3, 2}, {3, 0}}}, // 136
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{3, 2}, {0, 1}, {7, 6}, {0, 1}, {0, 4}, {7, 4}, {7, 6}}}, // 137
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{1, 0}, {1, 2}, {1, 5}, {7, 4}, {7, 6}, {3, 2}, {3, 0}}}, // 138
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{7, 6}, {3, 2}, {7, 4}, {3, 2}, {1, 2}, {1, 5}, {7, 4}, {1, 5}, {0, 4}, {7, 4}}}, // 139
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{7, 4}, {2, 1}, {3, 0}, {7, 4}, {7, 6}, {2, 6}, {2, 1}}}, // 140
+  {1, {6}, {{128, 0, 128}}, {{0, 1}, {0, 4}, {7, 4}, {7, 6}, {2, 6}, {2, 1}}}, // 141
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{1, 0}, {2, 6}, {1, 5}, {1, 0}, {7, 4}, {7, 6}, {2, 6}, {1, 0}, {3, 0}, {7, 4}}}, // 142
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{5, 1}, {4, 0}, {6, 2}, {4, 0}, {4, 7}, {6, 7}, {6, 2}}}, // 143
+  {1, {4}, {{0, 255, 0}}, {{4, 0}, {4, 5}, {7, 6}, {7, 3}}}, // 144
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{7, 6}, {0, 1}, {4, 5}, {7, 6}, {7, 3}, {0, 3}, {0, 1}}}, // 145
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{1, 0}, {1, 2}, {1, 5}, {4, 0}, {4, 5}, {7, 6}, {7, 3}}}, // 146
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{7, 3}, {4, 5}, {7, 6}, {7, 3}, {1, 2}, {1, 5}, {4, 5}, {7, 3}, {0, 3}, {1, 2}}}, // 147
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{2, 1}, {2, 3}, {2, 6}, {4, 0}, {4, 5}, {7, 6}, {7, 3}}}, // 148
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{7, 6}, {0, 1}, {4, 5}, {7, 6}, {7, 3}, {0, 3}, {0, 1}, {2, 1}, {2, 3}, {2, 6}}}, // 149
+  {2, {4, 4}, {{0, 255, 0}, {0, 255, 0}}, {{2, 3}, {2, 6}, {1, 5}, {1, 0}, {4, 0}, {4, 5}, {7, 6}, {7, 3}}}, // 150
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{3, 0}, {3, 2}, {3, 7}, {5, 1}, {5, 4}, {6, 7}, {6, 2}}}, // 151
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{7, 6}, {3, 2}, {4, 5}, {3, 2}, {3, 0}, {4, 0}, {4, 5}}}, // 152
+  {1, {4}, {{255, 255, 0}}, {{0, 1}, {4, 5}, {7, 6}, {3, 2}}}, // 153
+  {3, {3, 3, 4}, {{255, 0, 0}, {0, 0, 255}, {0, 0, 255}}, {{1, 0}, {1, 2}, {1, 5}, {7, 6}, {3, 2}, {4, 5}, {3, 2}, {3, 0}, {4, 0}, {4, 5}}}, // 154
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{6, 7}, {2, 3}, {5, 4}, {2, 3}, {2, 1}, {5, 1}, {5, 4}}}, // 155
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{2, 1}, {3, 0}, {2, 6}, {3, 0}, {4, 0}, {4, 5}, {2, 6}, {4, 5}, {7, 6}, {2, 6}}}, // 156
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{6, 7}, {1, 0}, {5, 4}, {6, 7}, {6, 2}, {1, 2}, {1, 0}}}, // 157
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{0, 1}, {0, 3}, {0, 4}, {5, 1}, {5, 4}, {6, 7}, {6, 2}}}, // 158
+  {1, {4}, {{0, 255, 0}}, {{5, 1}, {5, 4}, {6, 7}, {6, 2}}}, // 159
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{5, 6}, {5, 4}, {5, 1}, {7, 3}, {7, 4}, {7, 6}}}, // 160
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{0, 4}, {0, 3}, {0, 1}, {5, 6}, {5, 4}, {5, 1}, {7, 3}, {7, 4}, {7, 6}}}, // 161
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{1, 0}, {1, 2}, {5, 6}, {5, 4}, {7, 3}, {7, 4}, {7, 6}}}, // 162
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{5, 6}, {0, 3}, {1, 2}, {5, 6}, {5, 4}, {0, 4}, {0, 3}, {7, 3}, {7, 4}, {7, 6}}}, // 163
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{2, 1}, {2, 3}, {2, 6}, {5, 6}, {5, 4}, {5, 1}, {7, 3}, {7, 4}, {7, 6}}}, // 164
+  {4, {3, 3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{0, 4}, {0, 3}, {0, 1}, {2, 1}, {2, 3}, {2, 6}, {5, 6}, {5, 4}, {5, 1}, {7, 3}, {7, 4}, {7, 6}}}, // 165
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{2, 3}, {5, 4}, {1, 0}, {2, 3}, {2, 6}, {5, 6}, {5, 4}, {7, 3}, {7, 4}, {7, 6}}}, // 166
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{3, 0}, {3, 2}, {3, 7}, {4, 7}, {4, 5}, {4, 0}, {6, 2}, {6, 5}, {6, 7}}}, // 167
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{7, 4}, {7, 6}, {3, 2}, {3, 0}, {5, 6}, {5, 4}, {5, 1}}}, // 168
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{3, 2}, {0, 1}, {7, 6}, {0, 1}, {0, 4}, {7, 4}, {7, 6}, {5, 6}, {5, 4}, {5, 1}}}, // 169
+  {2, {4, 4}, {{0, 255, 0}, {0, 255, 0}}, {{1, 0}, {1, 2}, {5, 6}, {5, 4}, {7, 4}, {7, 6}, {3, 2}, {3, 0}}}, // 170
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{6, 5}, {6, 7}, {2, 3}, {2, 1}, {4, 7}, {4, 5}, {4, 0}}}, // 171
+  {3, {3, 4, 3}, {{0, 0, 255}, {0, 0, 255}, {255, 0, 0}}, {{7, 4}, {2, 1}, {3, 0}, {7, 4}, {7, 6}, {2, 6}, {2, 1}, {5, 6}, {5, 4}, {5, 1}}}, // 172
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{1, 5}, {1, 2}, {1, 0}, {4, 7}, {4, 5}, {4, 0}, {6, 2}, {6, 5}, {6, 7}}}, // 173
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{0, 1}, {0, 3}, {4, 7}, {4, 5}, {6, 2}, {6, 5}, {6, 7}}}, // 174
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{4, 7}, {4, 5}, {4, 0}, {6, 2}, {6, 5}, {6, 7}}}, // 175
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{5, 1}, {7, 3}, {4, 0}, {5, 1}, {5, 6}, {7, 6}, {7, 3}}}, // 176
+  {1, {6}, {{128, 0, 128}}, {{5, 1}, {5, 6}, {7, 6}, {7, 3}, {0, 3}, {0, 1}}}, // 177
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{1, 2}, {5, 6}, {1, 0}, {5, 6}, {7, 6}, {7, 3}, {1, 0}, {7, 3}, {4, 0}, {1, 0}}}, // 178
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{2, 1}, {6, 5}, {3, 0}, {6, 5}, {6, 7}, {3, 7}, {3, 0}}}, // 179
+  {3, {3, 3, 4}, {{255, 0, 0}, {0, 0, 255}, {0, 0, 255}}, {{2, 1}, {2, 3}, {2, 6}, {5, 1}, {7, 3}, {4, 0}, {5, 1}, {5, 6}, {7, 6}, {7, 3}}}, // 180
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{1, 5}, {1, 2}, {1, 0}, {3, 0}, {3, 2}, {3, 7}, {6, 2}, {6, 5}, {6, 7}}}, // 181
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{3, 2}, {3, 7}, {0, 4}, {0, 1}, {6, 2}, {6, 5}, {6, 7}}}, // 182
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{3, 0}, {3, 2}, {3, 7}, {6, 2}, {6, 5}, {6, 7}}}, // 183
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{3, 0}, {7, 6}, {3, 2}, {3, 0}, {5, 1}, {5, 6}, {7, 6}, {3, 0}, {4, 0}, {5, 1}}}, // 184
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{2, 3}, {1, 0}, {6, 7}, {1, 0}, {1, 5}, {6, 5}, {6, 7}}}, // 185
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{0, 1}, {0, 3}, {0, 4}, {6, 5}, {6, 7}, {2, 3}, {2, 1}}}, // 186
+  {1, {4}, {{0, 255, 0}}, {{6, 5}, {6, 7}, {2, 3}, {2, 1}}}, // 187
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{0, 3}, {0, 4}, {1, 5}, {1, 2}, {6, 2}, {6, 5}, {6, 7}}}, // 188
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{1, 5}, {1, 2}, {1, 0}, {6, 2}, {6, 5}, {6, 7}}}, // 189
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{0, 1}, {0, 3}, {0, 4}, {6, 2}, {6, 5}, {6, 7}}}, // 190
+  {1, {3}, {{255, 0, 0}}, {{6, 2}, {6, 5}, {6, 7}}}, // 191
+  {1, {4}, {{0, 255, 0}}, {{7, 3}, {7, 4}, {6, 5}, {6, 2}}}, // 192
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{0, 4}, {0, 3}, {0, 1}, {7, 3}, {7, 4}, {6, 5}, {6, 2}}}, // 193
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{1, 0}, {1, 2}, {1, 5}, {7, 3}, {7, 4}, {6, 5}, {6, 2}}}, // 194
+  {2, {4, 4}, {{0, 255, 0}, {0, 255, 0}}, {{1, 2}, {1, 5}, {0, 4}, {0, 3}, {7, 3}, {7, 4}, {6, 5}, {6, 2}}}, // 195
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{6, 5}, {2, 1}, {7, 4}, {2, 1}, {2, 3}, {7, 3}, {7, 4}}}, // 196
+  {3, {3, 3, 4}, {{255, 0, 0}, {0, 0, 255}, {0, 0, 255}}, {{0, 4}, {0, 3}, {0, 1}, {6, 5}, {2, 1}, {7, 4}, {2, 1}, {2, 3}, {7, 3}, {7, 4}}}, // 197
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{1, 0}, {2, 3}, {1, 5}, {2, 3}, {7, 3}, {7, 4}, {1, 5}, {7, 4}, {6, 5}, {1, 5}}}, // 198
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{3, 0}, {3, 2}, {3, 7}, {4, 0}, {4, 7}, {5, 6}, {5, 1}}}, // 199
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{6, 5}, {3, 0}, {7, 4}, {6, 5}, {6, 2}, {3, 2}, {3, 0}}}, // 200
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{0, 4}, {3, 2}, {0, 1}, {0, 4}, {6, 5}, {6, 2}, {3, 2}, {0, 4}, {7, 4}, {6, 5}}}, // 201
+  {3, {3, 3, 4}, {{255, 0, 0}, {0, 0, 255}, {0, 0, 255}}, {{1, 0}, {1, 2}, {1, 5}, {6, 5}, {3, 0}, {7, 4}, {6, 5}, {6, 2}, {3, 2}, {3, 0}}}, // 202
+  {2, {3, 4}, {{255, 0, 0}, {0, 255, 0}}, {{2, 6}, {2, 3}, {2, 1}, {4, 0}, {4, 7}, {5, 6}, {5, 1}}}, // 203
+  {1, {4}, {{255, 255, 0}}, {{3, 0}, {7, 4}, {6, 5}, {2, 1}}}, // 204
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{5, 6}, {1, 2}, {4, 7}, {1, 2}, {1, 0}, {4, 0}, {4, 7}}}, // 205
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{5, 6}, {0, 3}, {4, 7}, {5, 6}, {5, 1}, {0, 1}, {0, 3}}}, // 206
+  {1, {4}, {{0, 255, 0}}, {{4, 0}, {4, 7}, {5, 6}, {5, 1}}}, // 207
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{7, 3}, {4, 0}, {6, 2}, {4, 0}, {4, 5}, {6, 5}, {6, 2}}}, // 208
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{0, 1}, {4, 5}, {0, 3}, {4, 5}, {6, 5}, {6, 2}, {0, 3}, {6, 2}, {7, 3}, {0, 3}}}, // 209
+  {3, {3, 3, 4}, {{255, 0, 0}, {0, 0, 255}, {0, 0, 255}}, {{1, 0}, {1, 2}, {1, 5}, {7, 3}, {4, 0}, {6, 2}, {4, 0}, {4, 5}, {6, 5}, {6, 2}}}, // 210
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{2, 1}, {2, 6}, {3, 7}, {3, 0}, {5, 1}, {5, 4}, {5, 6}}}, // 211
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{2, 3}, {6, 5}, {2, 1}, {2, 3}, {4, 0}, {4, 5}, {6, 5}, {2, 3}, {7, 3}, {4, 0}}}, // 212
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{5, 4}, {5, 6}, {1, 2}, {1, 0}, {3, 0}, {3, 2}, {3, 7}}}, // 213
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{3, 2}, {3, 7}, {0, 4}, {0, 1}, {5, 1}, {5, 4}, {5, 6}}}, // 214
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{3, 0}, {3, 2}, {3, 7}, {5, 1}, {5, 4}, {5, 6}}}, // 215
+  {1, {6}, {{128, 0, 128}}, {{4, 0}, {4, 5}, {6, 5}, {6, 2}, {3, 2}, {3, 0}}}, // 216
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{1, 0}, {5, 4}, {2, 3}, {5, 4}, {5, 6}, {2, 6}, {2, 3}}}, // 217
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{0, 1}, {0, 3}, {0, 4}, {2, 6}, {2, 3}, {2, 1}, {5, 1}, {5, 4}, {5, 6}}}, // 218
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{2, 6}, {2, 3}, {2, 1}, {5, 1}, {5, 4}, {5, 6}}}, // 219
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{1, 2}, {0, 3}, {5, 6}, {0, 3}, {0, 4}, {5, 4}, {5, 6}}}, // 220
+  {1, {4}, {{0, 255, 0}}, {{5, 4}, {5, 6}, {1, 2}, {1, 0}}}, // 221
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{0, 1}, {0, 3}, {0, 4}, {5, 1}, {5, 4}, {5, 6}}}, // 222
+  {1, {3}, {{255, 0, 0}}, {{5, 1}, {5, 4}, {5, 6}}}, // 223
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{7, 3}, {5, 1}, {6, 2}, {7, 3}, {7, 4}, {5, 4}, {5, 1}}}, // 224
+  {3, {3, 3, 4}, {{255, 0, 0}, {0, 0, 255}, {0, 0, 255}}, {{0, 4}, {0, 3}, {0, 1}, {7, 3}, {5, 1}, {6, 2}, {7, 3}, {7, 4}, {5, 4}, {5, 1}}}, // 225
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{1, 2}, {5, 4}, {1, 0}, {1, 2}, {7, 3}, {7, 4}, {5, 4}, {1, 2}, {6, 2}, {7, 3}}}, // 226
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{2, 1}, {2, 6}, {3, 7}, {3, 0}, {4, 7}, {4, 5}, {4, 0}}}, // 227
+  {1, {6}, {{128, 0, 128}}, {{2, 1}, {2, 3}, {7, 3}, {7, 4}, {5, 4}, {5, 1}}}, // 228
+  {3, {3, 3, 3}, {{255, 0, 0}, {255, 0, 0}, {255, 0, 0}}, {{1, 5}, {1, 2}, {1, 0}, {3, 0}, {3, 2}, {3, 7}, {4, 7}, {4, 5}, {4, 0}}}, // 229
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{3, 2}, {4, 5}, {0, 1}, {3, 2}, {3, 7}, {4, 7}, {4, 5}}}, // 230
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{3, 0}, {3, 2}, {3, 7}, {4, 7}, {4, 5}, {4, 0}}}, // 231
+  {3, {3, 4, 3}, {{128, 128, 128}, {128, 128, 128}, {128, 128, 128}}, {{3, 0}, {7, 4}, {3, 2}, {7, 4}, {5, 4}, {5, 1}, {3, 2}, {5, 1}, {6, 2}, {3, 2}}}, // 232
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{1, 0}, {1, 5}, {2, 6}, {2, 3}, {4, 7}, {4, 5}, {4, 0}}}, // 233
+  {2, {4, 3}, {{0, 255, 0}, {255, 0, 0}}, {{0, 1}, {0, 3}, {4, 7}, {4, 5}, {2, 6}, {2, 3}, {2, 1}}}, // 234
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{2, 6}, {2, 3}, {2, 1}, {4, 7}, {4, 5}, {4, 0}}}, // 235
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{0, 3}, {4, 7}, {1, 2}, {4, 7}, {4, 5}, {1, 5}, {1, 2}}}, // 236
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{1, 5}, {1, 2}, {1, 0}, {4, 7}, {4, 5}, {4, 0}}}, // 237
+  {1, {4}, {{0, 255, 0}}, {{0, 1}, {0, 3}, {4, 7}, {4, 5}}}, // 238
+  {1, {3}, {{255, 0, 0}}, {{4, 7}, {4, 5}, {4, 0}}}, // 239
+  {1, {4}, {{255, 255, 0}}, {{5, 1}, {6, 2}, {7, 3}, {4, 0}}}, // 240
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{3, 7}, {1, 5}, {2, 6}, {3, 7}, {3, 0}, {1, 0}, {1, 5}}}, // 241
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{3, 7}, {0, 4}, {2, 6}, {0, 4}, {0, 1}, {2, 1}, {2, 6}}}, // 242
+  {1, {4}, {{0, 255, 0}}, {{2, 1}, {2, 6}, {3, 7}, {3, 0}}}, // 243
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{1, 5}, {3, 7}, {0, 4}, {1, 5}, {1, 2}, {3, 2}, {3, 7}}}, // 244
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{1, 5}, {1, 2}, {1, 0}, {3, 0}, {3, 2}, {3, 7}}}, // 245
+  {1, {4}, {{0, 255, 0}}, {{3, 2}, {3, 7}, {0, 4}, {0, 1}}}, // 246
+  {1, {3}, {{255, 0, 0}}, {{3, 0}, {3, 2}, {3, 7}}}, // 247
+  {2, {3, 4}, {{0, 0, 255}, {0, 0, 255}}, {{2, 6}, {0, 4}, {1, 5}, {2, 6}, {2, 3}, {0, 3}, {0, 4}}}, // 248
+  {1, {4}, {{0, 255, 0}}, {{1, 0}, {1, 5}, {2, 6}, {2, 3}}}, // 249
+  {2, {3, 3}, {{255, 0, 0}, {255, 0, 0}}, {{0, 1}, {0, 3}, {0, 4}, {2, 6}, {2, 3}, {2, 1}}}, // 250
+  {1, {3}, {{255, 0, 0}}, {{2, 6}, {2, 3}, {2, 1}}}, // 251
+  {1, {4}, {{0, 255, 0}}, {{0, 3}, {0, 4}, {1, 5}, {1, 2}}}, // 252
+  {1, {3}, {{255, 0, 0}}, {{1, 5}, {1, 2}, {1, 0}}}, // 253
+  {1, {3}, {{255, 0, 0}}, {{0, 1}, {0, 3}, {0, 4}}}, // 254
+  {0, {}, {}, {}}, // 255
+};
+
+#endif
@@ -0,0 +1,102 @@
+#include "baked.h"
+
+namespace mesh {
+  // === Triangle records ===
+  Vertex3D TriangleRecord::get_vertex(int i) const {
+    if (i == 1) {
+      return Vertex3D(v0[0] + e1[0], v0[1] + e1[1], v0[2] + e1[2]);
+    }
+    if (i == 2) {
+      return Vertex3D(v0[0] + e2[0], v0[1] + e2[1], v0[2] + e2[2]);
+    }
+    return Vertex3D(v0[0], v0[1], v0[2]);
+  }
+
+  Vertex3D TriangleRecord::get_edge1() const {
+    return Vertex3D(e1[0], e1[1], e1[2]);
+  }
+
+  Vertex3D TriangleRecord::get_edge2() const {
+    return Vertex3D(e2[0], e2[1], e2[2]);
+  }
+
+  Vertex3D TriangleRecord::get_normal() const {
+    return Vertex3D(normal[0], normal[1], normal[2]);
+  }
+
+  // v0 + (e1 + e2) / 3
+  Vertex3D TriangleRecord::get_midpoint() const {
+    return Vertex3D(
+      v0[0] + ((double)e1[0] + e2[0]) / 3.0,
+      v0[1] + ((double)e1[1] + e2[1]) / 3.0,
+      v0[2] + ((double)e1[2] + e2[2]) / 3.0
+    );
+  }
+
+  // === Baking ===
+  BakedMesh::BakedMesh(Mesh& mesh) {
+    int face_count = mesh.get_face_count();
+    triangles.reserve(face_count);
+    std::vector<Vertex3D> normals = mesh.get_face_normals();
+    for (int f = 0; f < face_count; f++) {
+      FaceView face = mesh.get_face_view(f);
+      // Points and segments have no triangles
+      if (face.size() < 3) {
+        continue;
+      }
+      Vertex3D v0 = face.vertex(0);
+      for (int i = 1; i + 1 < face.size(); i++) {
+        Vertex3D e1 = face.vertex(i) - v0;
+        Vertex3D e2 = face.vertex(i + 1) - v0;
+        TriangleRecord record;
+        record.v0[0] = v0.x; record.v0[1] = v0.y; record.v0[2] = v0.z;
+        record.e1[0] = e1.x; record.e1[1] = e1.y; record.e1[2] = e1.z;
+        record.e2[0] = e2.x; record.e2[1] = e2.y; record.e2[2] = e2.z;
+        record.normal[0] = normals[f].x; record.normal[1] = normals[f].y; record.normal[2] = normals[f].z;
+        record.r = face.r;
+        record.g = face.g;
+        record.b = face.b;
+        record.face = f;
+        triangles.push_back(record);
+      }
+    }
+    // Bounding sphere
+    if (triangles.empty()) {
+      bounds = BoundingSphere{Vertex3D(), 0};
+      return;
+    }
+    Vertex3D min = triangles[0].get_vertex(0);
+    Vertex3D max = min;
+    for (const TriangleRecord& triangle : triangles) {
+      for (int i = 0; i < 3; i++) {
+        Vertex3D v = triangle.get_vertex(i);
+        min = Vertex3D(std::min(min.x, v.x), std::min(min.y, v.y), std::min(min.z, v.z));
+        max = Vertex3D(std::max(max.x, v.x), std::max(max.y, v.y), std::max(max.z, v.z));
+      }
+    }
+    Vertex3D center = (min + max) / 2.0;
+    double radius = 0;
+    for (const TriangleRecord& triangle : triangles) {
+      for (int i = 0; i < 3; i++) {
+        radius = std::max(radius, (triangle.get_vertex(i) - center).magnitude());
+      }
+    }
+    bounds = BoundingSphere{center, radius};
+  }
+
+  const std::vector<TriangleRecord>& BakedMesh::get_triangles() const {
+    return triangles;
+  }
+
+  const TriangleRecord& BakedMesh::get_triangle(int index) const {
+    return triangles[index];
+  }
+
+  int BakedMesh::size() const {
+    return triangles.size();
+  }
+
+  const BoundingSphere& BakedMesh::get_bounds() const {
+    return bounds;
+  }
+}
@@ -0,0 +1,51 @@
+#include <vector>
+#include <cstdint>
+#include "3d.h"
+#include "mesh.h"
+
+#ifndef MESH_BAKED_H
+#define MESH_BAKED_H
+
+namespace mesh {
+  // Render-ready triangle: first vertex, the two edges leaving it, the unit
+  // normal of its face and the face colour, packed in floats
+  struct TriangleRecord {
+    float v0[3];
+    float e1[3];
+    float e2[3];
+    float normal[3];
+    std::uint8_t r, g, b;
+    int face;
+    // i = 0, 1, 2
+    Vertex3D get_vertex(int i) const;
+    Vertex3D get_edge1() const;
+    Vertex3D get_edge2() const;
+    Vertex3D get_normal() const;
+    Vertex3D get_midpoint() const;
+  };
+
+  struct BoundingSphere {
+    Vertex3D center;
+    double radius;
+  };
+
+  // Triangles of a mesh baked once into a contiguous array, so renderers do not
+  // rebuild planes, normals or edges per ray or per pixel.
+  // Faces with more than 3 vertices are fanned around their first vertex and
+  // share the normal of the face (from its first three vertices, like
+  // Face3D::get_normal). Bake again after changing the mesh
+  class BakedMesh {
+  private:
+    std::vector<TriangleRecord> triangles;
+    BoundingSphere bounds;
+  public:
+    BakedMesh(Mesh& mesh);
+    const std::vector<TriangleRecord>& get_triangles() const;
+    const TriangleRecord& get_triangle(int index) const;
+    int size() const;
+    // Sphere around the center of the bounding box that contains every triangle
+    const BoundingSphere& get_bounds() const;
+  };
+}
+
+#endif
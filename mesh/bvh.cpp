@@ -0,0 +1,261 @@
+#include "bvh.h"
+
+namespace mesh {
+  // Number of centroid bins per axis evaluated by the SAH
+  const int BVH_BINS = 16;
+  // Traversal stack size. Build stops splitting at this depth, so it never overflows
+  const int BVH_STACK_SIZE = 64;
+
+  // === AABB ===
+  void AABB::grow(const Vertex3D& v) {
+    min = Vertex3D(std::min(min.x, v.x), std::min(min.y, v.y), std::min(min.z, v.z));
+    max = Vertex3D(std::max(max.x, v.x), std::max(max.y, v.y), std::max(max.z, v.z));
+  }
+
+  void AABB::grow(const AABB& other) {
+    grow(other.min);
+    grow(other.max);
+  }
+
+  double AABB::area() const {
+    double dx = max.x - min.x;
+    double dy = max.y - min.y;
+    double dz = max.z - min.z;
+    if (dx < 0 || dy < 0 || dz < 0) {
+      return 0;
+    }
+    return 2 * (dx * dy + dy * dz + dz * dx);
+  }
+
+  double get_axis(const Vertex3D& v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+  }
+
+  double intersect_aabb(const AABB& box, const Vertex3D& origin, const Vertex3D& inv_direction, double t_min, double t_max) {
+    double tx1 = (box.min.x - origin.x) * inv_direction.x;
+    double tx2 = (box.max.x - origin.x) * inv_direction.x;
+    double t_near = std::max(t_min, std::min(tx1, tx2));
+    double t_far = std::min(t_max, std::max(tx1, tx2));
+    double ty1 = (box.min.y - origin.y) * inv_direction.y;
+    double ty2 = (box.max.y - origin.y) * inv_direction.y;
+    t_near = std::max(t_near, std::min(ty1, ty2));
+    t_far = std::min(t_far, std::max(ty1, ty2));
+    double tz1 = (box.min.z - origin.z) * inv_direction.z;
+    double tz2 = (box.max.z - origin.z) * inv_direction.z;
+    t_near = std::max(t_near, std::min(tz1, tz2));
+    t_far = std::min(t_far, std::max(tz1, tz2));
+    if (t_near > t_far) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return t_near;
+  }
+
+  // === Build ===
+  std::vector<int> get_all_triangles(const BakedMesh& baked) {
+    std::vector<int> ids(baked.size());
+    for (int i = 0; i < baked.size(); i++) {
+      ids[i] = i;
+    }
+    return ids;
+  }
+
+  BVH::BVH(const BakedMesh& baked) : BVH(baked, get_all_triangles(baked)) {}
+
+  BVH::BVH(const BakedMesh& baked, const std::vector<int>& triangle_ids) : baked(&baked), triangles(triangle_ids) {
+    centroids.reserve(triangles.size());
+    for (int id : triangles) {
+      centroids.push_back(baked.get_triangle(id).get_midpoint());
+    }
+    // Root holds every triangle
+    nodes.reserve(triangles.empty() ? 1 : 2 * triangles.size() - 1);
+    nodes.push_back(BVHNode{AABB(), 0, (int)triangles.size()});
+    update_bounds(0);
+    subdivide(0, 1);
+    build_packets();
+  }
+
+  void BVH::update_bounds(int node_id) {
+    BVHNode& node = nodes[node_id];
+    node.bounds = AABB();
+    for (int i = node.left_first; i < node.left_first + node.count; i++) {
+      const TriangleRecord& triangle = baked->get_triangle(triangles[i]);
+      node.bounds.grow(triangle.get_vertex(0));
+      node.bounds.grow(triangle.get_vertex(1));
+      node.bounds.grow(triangle.get_vertex(2));
+    }
+  }
+
+  // Binned SAH. Returns false when no split beats keeping the node as a leaf
+  bool BVH::find_split(const BVHNode& node, int& axis, double& position, double& cost) {
+    cost = std::numeric_limits<double>::max();
+    int first = node.left_first;
+    int last = node.left_first + node.count;
+    for (int a = 0; a < 3; a++) {
+      // Bin on centroid bounds
+      double lo = std::numeric_limits<double>::max();
+      double hi = std::numeric_limits<double>::lowest();
+      for (int i = first; i < last; i++) {
+        lo = std::min(lo, get_axis(centroids[i], a));
+        hi = std::max(hi, get_axis(centroids[i], a));
+      }
+      if (lo == hi) {
+        continue;
+      }
+      AABB bin_bounds[BVH_BINS];
+      int bin_count[BVH_BINS] = {0};
+      double scale = BVH_BINS / (hi - lo);
+      for (int i = first; i < last; i++) {
+        int bin = std::min(BVH_BINS - 1, (int)((get_axis(centroids[i], a) - lo) * scale));
+        const TriangleRecord& triangle = baked->get_triangle(triangles[i]);
+        bin_count[bin]++;
+        bin_bounds[bin].grow(triangle.get_vertex(0));
+        bin_bounds[bin].grow(triangle.get_vertex(1));
+        bin_bounds[bin].grow(triangle.get_vertex(2));
+      }
+      // Sweep from both sides to get the area and count left/right of each plane
+      double left_area[BVH_BINS - 1], right_area[BVH_BINS - 1];
+      int left_count[BVH_BINS - 1], right_count[BVH_BINS - 1];
+      AABB left_box, right_box;
+      int left_sum = 0, right_sum = 0;
+      for (int i = 0; i < BVH_BINS - 1; i++) {
+        left_sum += bin_count[i];
+        left_count[i] = left_sum;
+        left_box.grow(bin_bounds[i]);
+        left_area[i] = left_box.area();
+        right_sum += bin_count[BVH_BINS - 1 - i];
+        right_count[BVH_BINS - 2 - i] = right_sum;
+        right_box.grow(bin_bounds[BVH_BINS - 1 - i]);
+        right_area[BVH_BINS - 2 - i] = right_box.area();
+      }
+      for (int i = 0; i < BVH_BINS - 1; i++) {
+        if (left_count[i] == 0 || right_count[i] == 0) {
+          continue;
+        }
+        double plane_cost = left_count[i] * left_area[i] + right_count[i] * right_area[i];
+        if (plane_cost < cost) {
+          cost = plane_cost;
+          axis = a;
+          position = lo + (i + 1) / scale;
+        }
+      }
+    }
+    // Leaf cost: test every triangle
+    return cost < node.count * node.bounds.area();
+  }
+
+  void BVH::subdivide(int node_id, int depth) {
+    int axis;
+    double position, cost;
+    if (nodes[node_id].count <= 1 || depth >= BVH_STACK_SIZE || !find_split(nodes[node_id], axis, position, cost)) {
+      return;
+    }
+    // Partition triangles around the split plane
+    int first = nodes[node_id].left_first;
+    int count = nodes[node_id].count;
+    int i = first;
+    int j = first + count - 1;
+    while (i <= j) {
+      if (get_axis(centroids[i], axis) < position) {
+        i++;
+      }
+      else {
+        std::swap(triangles[i], triangles[j]);
+        std::swap(centroids[i], centroids[j]);
+        j--;
+      }
+    }
+    int left_count = i - first;
+    if (left_count == 0 || left_count == count) {
+      return;
+    }
+    // Children are stored next to each other
+    int left_id = nodes.size();
+    nodes.push_back(BVHNode{AABB(), first, left_count});
+    nodes.push_back(BVHNode{AABB(), i, count - left_count});
+    nodes[node_id].left_first = left_id;
+    nodes[node_id].count = 0;
+    update_bounds(left_id);
+    update_bounds(left_id + 1);
+    subdivide(left_id, depth + 1);
+    subdivide(left_id + 1, depth + 1);
+  }
+
+  // Regroup the triangles of each leaf into packets. From here on leaves
+  // index packets instead of triangles
+  void BVH::build_packets() {
+    for (BVHNode& node : nodes) {
+      if (!node.is_leaf()) {
+        continue;
+      }
+      int first_packet = packets.size();
+      for (int i = node.left_first; i < node.left_first + node.count; i += PACKET_WIDTH) {
+        TrianglePacket packet;
+        for (int lane = 0; lane < PACKET_WIDTH && i + lane < node.left_first + node.count; lane++) {
+          packet.set(lane, baked->get_triangle(triangles[i + lane]), triangles[i + lane]);
+        }
+        packets.push_back(packet);
+      }
+      node.left_first = first_packet;
+      node.count = packets.size() - first_packet;
+    }
+  }
+
+  // === Traversal ===
+  std::optional<BVHHit> BVH::intersect(const Line3D& ray, double t_min, double t_max, bool cull_back_faces) {
+    if (triangles.empty()) {
+      return std::nullopt;
+    }
+    Vertex3D inv_direction(1.0 / ray.direction.x, 1.0 / ray.direction.y, 1.0 / ray.direction.z);
+    int closest = -1;
+    double closest_t = t_max;
+    int stack[BVH_STACK_SIZE];
+    int stack_size = 0;
+    if (intersect_aabb(nodes[0].bounds, ray.point, inv_direction, t_min, closest_t) == std::numeric_limits<double>::infinity()) {
+      return std::nullopt;
+    }
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+      const BVHNode& node = nodes[stack[--stack_size]];
+      if (node.is_leaf()) {
+        for (int i = node.left_first; i < node.left_first + node.count; i++) {
+          int lane = intersect_packet(packets[i], ray, t_min, closest_t, cull_back_faces);
+          if (lane >= 0) {
+            closest = packets[i].id[lane];
+          }
+        }
+        continue;
+      }
+      // Push the far child first so the near one is visited next
+      int near_id = node.left_first;
+      int far_id = node.left_first + 1;
+      double near_t = intersect_aabb(nodes[near_id].bounds, ray.point, inv_direction, t_min, closest_t);
+      double far_t = intersect_aabb(nodes[far_id].bounds, ray.point, inv_direction, t_min, closest_t);
+      if (far_t < near_t) {
+        std::swap(near_id, far_id);
+        std::swap(near_t, far_t);
+      }
+      if (far_t != std::numeric_limits<double>::infinity()) {
+        stack[stack_size++] = far_id;
+      }
+      if (near_t != std::numeric_limits<double>::infinity()) {
+        stack[stack_size++] = near_id;
+      }
+    }
+    if (closest < 0) {
+      return std::nullopt;
+    }
+    return BVHHit{closest_t, closest, baked->get_triangle(closest).face, ray.point + ray.direction * closest_t};
+  }
+
+  const AABB& BVH::get_bounds() {
+    return nodes[0].bounds;
+  }
+
+  int BVH::get_node_count() {
+    return nodes.size();
+  }
+
+  int BVH::get_triangle_count() {
+    return triangles.size();
+  }
+}
@@ -0,0 +1,84 @@
+#include <vector>
+#include <limits>
+#include <optional>
+#include "3d.h"
+#include "baked.h"
+#include "intersect.h"
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+namespace mesh {
+  // Axis aligned bounding box
+  struct AABB {
+    Vertex3D min = Vertex3D(
+      std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::max()
+    );
+    Vertex3D max = Vertex3D(
+      std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::lowest()
+    );
+    void grow(const Vertex3D& v);
+    void grow(const AABB& other);
+    double area() const;
+  };
+
+  // Entry distance of a ray in a box within [t_min, t_max], infinity on a miss
+  double intersect_aabb(const AABB& box, const Vertex3D& origin, const Vertex3D& inv_direction, double t_min, double t_max);
+  double get_axis(const Vertex3D& v, int axis);
+
+  // Flattened node. Inner nodes (count == 0) have their children at
+  // left_first and left_first + 1. Leaves hold count triangle packets starting at left_first
+  struct BVHNode {
+    AABB bounds;
+    int left_first;
+    int count;
+    bool is_leaf() const { return count > 0; }
+  };
+
+  struct BVHHit {
+    double t;
+    // Index in the baked mesh and face of the source mesh
+    int triangle;
+    int face;
+    Vertex3D point;
+  };
+
+  // Bounding volume hierarchy over the triangles of a baked mesh, built with a
+  // binned surface area heuristic. Keeps a pointer to the baked mesh
+  class BVH {
+  private:
+    const BakedMesh* baked;
+    // Baked triangle ids, reordered so every node covers a contiguous range
+    std::vector<int> triangles;
+    std::vector<Vertex3D> centroids;
+    std::vector<BVHNode> nodes;
+    std::vector<TrianglePacket> packets;
+
+    void update_bounds(int node_id);
+    void subdivide(int node_id, int depth);
+    bool find_split(const BVHNode& node, int& axis, double& position, double& cost);
+    void build_packets();
+  public:
+    BVH(const BakedMesh& baked);
+    // Only over the given triangles, e.g. the ones left by cull_triangles
+    BVH(const BakedMesh& baked, const std::vector<int>& triangle_ids);
+    // Closest hit with t_min <= t <= t_max along ray.point + ray.direction * t.
+    // cull_back_faces skips triangles facing away from the ray, see intersect_packet
+    std::optional<BVHHit> intersect(
+      const Line3D& ray,
+      double t_min = 0,
+      double t_max = std::numeric_limits<double>::max(),
+      bool cull_back_faces = false
+    );
+    // Bounds of every triangle in the tree
+    const AABB& get_bounds();
+    int get_node_count();
+    int get_triangle_count();
+  };
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "cull.h"
+
+namespace mesh {
+  // Planes through the eye and the film edges plus the film plane itself.
+  // A point p is inside plane i when dot(normal_i, p) + offset_i >= 0
+  struct FrustumPlanes {
+    Vertex3D normals[5];
+    double offsets[5];
+  };
+
+  FrustumPlanes get_frustum_planes(const ViewFrustum& frustum) {
+    double d = frustum.distance;
+    double w = frustum.half_width;
+    double h = frustum.half_height;
+    FrustumPlanes planes;
+    // x >= -w z / d, x <= w z / d, same for y
+    planes.normals[0] = Vertex3D(d, 0, w).normalized();
+    planes.normals[1] = Vertex3D(-d, 0, w).normalized();
+    planes.normals[2] = Vertex3D(0, d, h).normalized();
+    planes.normals[3] = Vertex3D(0, -d, h).normalized();
+    for (int i = 0; i < 4; i++) {
+      planes.offsets[i] = 0;
+    }
+    // z >= d, renderers ignore anything in front of the film
+    planes.normals[4] = Vertex3D(0, 0, 1);
+    planes.offsets[4] = -d;
+    return planes;
+  }
+
+  double plane_distance(const FrustumPlanes& planes, int i, const Vertex3D& p) {
+    return dot_product(planes.normals[i], p) + planes.offsets[i];
+  }
+
+  bool sphere_in_frustum(const BoundingSphere& sphere, const ViewFrustum& frustum) {
+    FrustumPlanes planes = get_frustum_planes(frustum);
+    for (int i = 0; i < 5; i++) {
+      if (plane_distance(planes, i, sphere.center) < -sphere.radius) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<int> cull_triangles(const BakedMesh& baked, const ViewFrustum& frustum, int flags, const Transform3D& transform) {
+    std::vector<int> visible;
+    FrustumPlanes planes = get_frustum_planes(frustum);
+    bool test_frustum = flags & CULL_FRUSTUM;
+    bool transformed = !transform.is_identity();
+    if (flags & CULL_BOUNDING_SPHERE) {
+      BoundingSphere bounds = transform.apply(baked.get_bounds());
+      bool inside = true;
+      for (int i = 0; i < 5; i++) {
+        double distance = plane_distance(planes, i, bounds.center);
+        if (distance < -bounds.radius) {
+          return visible;
+        }
+        if (distance < bounds.radius) {
+          inside = false;
+        }
+      }
+      if (inside) {
+        test_frustum = false;
+      }
+    }
+    visible.reserve(baked.size());
+    const std::vector<TriangleRecord>& triangles = baked.get_triangles();
+    for (int id = 0; id < (int) triangles.size(); id++) {
+      TriangleRecord triangle = transformed ? transform.apply(triangles[id]) : triangles[id];
+      Vertex3D v0 = triangle.get_vertex(0);
+      // The eye is the origin, so v0 is the direction from the eye to the face
+      if ((flags & CULL_BACK_FACES) && dot_product(triangle.get_normal(), v0) >= 0) {
+        continue;
+      }
+      if (test_frustum) {
+        Vertex3D v1 = triangle.get_vertex(1);
+        Vertex3D v2 = triangle.get_vertex(2);
+        bool outside = false;
+        for (int i = 0; i < 5 && !outside; i++) {
+          outside = plane_distance(planes, i, v0) < 0
+            && plane_distance(planes, i, v1) < 0
+            && plane_distance(planes, i, v2) < 0;
+        }
+        if (outside) {
+          continue;
+        }
+      }
+      visible.push_back(id);
+    }
+    return visible;
+  }
+}
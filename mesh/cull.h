@@ -0,0 +1,42 @@
+#include <vector>
+#include "3d.h"
+#include "baked.h"
+#include "transform.h"
+
+#ifndef MESH_CULL_H
+#define MESH_CULL_H
+
+namespace mesh {
+  // Pinhole view with the eye at the origin looking down +z. The film sits at
+  // z = distance and spans [-half_width, half_width] x [-half_height, half_height]
+  struct ViewFrustum {
+    double distance;
+    double half_width, half_height;
+  };
+
+  // Tests run by cull_triangles, combined with |
+  enum CullFlags {
+    CULL_NONE = 0,
+    // Drop triangles whose normal points away from the eye
+    CULL_BACK_FACES = 1,
+    // Drop triangles with every vertex outside the same frustum plane
+    CULL_FRUSTUM = 2,
+    // Classify the mesh bounding sphere first: drop everything when it is
+    // outside, skip the per triangle frustum test when it is inside
+    CULL_BOUNDING_SPHERE = 4,
+    CULL_ALL = CULL_BACK_FACES | CULL_FRUSTUM | CULL_BOUNDING_SPHERE,
+  };
+
+  // Ids of the triangles of baked that may be visible through frustum when the
+  // mesh is placed by transform. Back face culling relies on consistent outward winding
+  std::vector<int> cull_triangles(
+    const BakedMesh& baked,
+    const ViewFrustum& frustum,
+    int flags = CULL_ALL,
+    const Transform3D& transform = Transform3D()
+  );
+  // Whether a bounding sphere is at least partly inside frustum
+  bool sphere_in_frustum(const BoundingSphere& sphere, const ViewFrustum& frustum);
+}
+
+#endif
@@ -70,4 +70,49 @@ namespace mesh {
 
     return Mesh(f);
   }
+
+
+  Mesh unitCircleIcosahedron() {
+    // Vertex of icosahedron: cyclic permutations of (0, +-1, +-phi)
+    // normalized to the unit sphere
+    double phi = (1.0 + std::sqrt(5.0)) / 2.0;
+    std::vector<Vertex3D> v = {
+      Vertex3D(-1, phi, 0).normalized(),
+      Vertex3D(1, phi, 0).normalized(),
+      Vertex3D(-1, -phi, 0).normalized(),
+      Vertex3D(1, -phi, 0).normalized(),
+      Vertex3D(0, -1, phi).normalized(),
+      Vertex3D(0, 1, phi).normalized(),
+      Vertex3D(0, -1, -phi).normalized(),
+      Vertex3D(0, 1, -phi).normalized(),
+      Vertex3D(phi, 0, -1).normalized(),
+      Vertex3D(phi, 0, 1).normalized(),
+      Vertex3D(-phi, 0, -1).normalized(),
+      Vertex3D(-phi, 0, 1).normalized()
+    };
+    std::vector<Face3D> f = {
+      Face3D({v[0], v[11], v[5]}),
+      Face3D({v[0], v[5], v[1]}),
+      Face3D({v[0], v[1], v[7]}),
+      Face3D({v[0], v[7], v[10]}),
+      Face3D({v[0], v[10], v[11]}),
+      Face3D({v[1], v[5], v[9]}),
+      Face3D({v[5], v[11], v[4]}),
+      Face3D({v[11], v[10], v[2]}),
+      Face3D({v[10], v[7], v[6]}),
+      Face3D({v[7], v[1], v[8]}),
+      Face3D({v[3], v[9], v[4]}),
+      Face3D({v[3], v[4], v[2]}),
+      Face3D({v[3], v[2], v[6]}),
+      Face3D({v[3], v[6], v[8]}),
+      Face3D({v[3], v[8], v[9]}),
+      Face3D({v[4], v[9], v[5]}),
+      Face3D({v[2], v[4], v[11]}),
+      Face3D({v[6], v[2], v[10]}),
+      Face3D({v[8], v[6], v[7]}),
+      Face3D({v[9], v[8], v[1]})
+    };
+
+    return Mesh(f);
+  }
 }
\ No newline at end of file
@@ -8,5 +8,6 @@
 namespace mesh {
   Mesh unitCircleCube();
   Mesh unitCircleTetrahedron();
+  Mesh unitCircleIcosahedron();
 }
 #endif
\ No newline at end of file
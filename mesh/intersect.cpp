@@ -0,0 +1,177 @@
+#include "intersect.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mesh {
+  TrianglePacket::TrianglePacket() {
+    for (int lane = 0; lane < PACKET_WIDTH; lane++) {
+      v0x[lane] = v0y[lane] = v0z[lane] = 0;
+      e1x[lane] = e1y[lane] = e1z[lane] = 0;
+      e2x[lane] = e2y[lane] = e2z[lane] = 0;
+      id[lane] = -1;
+    }
+  }
+
+  void TrianglePacket::set(int lane, const TriangleRecord& triangle, int id) {
+    v0x[lane] = triangle.v0[0]; v0y[lane] = triangle.v0[1]; v0z[lane] = triangle.v0[2];
+    e1x[lane] = triangle.e1[0]; e1y[lane] = triangle.e1[1]; e1z[lane] = triangle.e1[2];
+    e2x[lane] = triangle.e2[0]; e2y[lane] = triangle.e2[1]; e2z[lane] = triangle.e2[2];
+    this->id[lane] = id;
+  }
+
+  // Moller-Trumbore, PACKET_WIDTH triangles at a time. det = -direction . (e1 x e2),
+  // so front faces have det > 0 and back faces det < 0
+#ifdef __AVX__
+  int intersect_packet(const TrianglePacket& packet, const Line3D& ray, double t_min, double& t_max, bool cull_back_faces) {
+    __m256d dx = _mm256_set1_pd(ray.direction.x);
+    __m256d dy = _mm256_set1_pd(ray.direction.y);
+    __m256d dz = _mm256_set1_pd(ray.direction.z);
+    __m256d e1x = _mm256_load_pd(packet.e1x);
+    __m256d e1y = _mm256_load_pd(packet.e1y);
+    __m256d e1z = _mm256_load_pd(packet.e1z);
+    __m256d e2x = _mm256_load_pd(packet.e2x);
+    __m256d e2y = _mm256_load_pd(packet.e2y);
+    __m256d e2z = _mm256_load_pd(packet.e2z);
+    // p = direction x e2, det = e1 . p
+    __m256d px = _mm256_sub_pd(_mm256_mul_pd(dy, e2z), _mm256_mul_pd(dz, e2y));
+    __m256d py = _mm256_sub_pd(_mm256_mul_pd(dz, e2x), _mm256_mul_pd(dx, e2z));
+    __m256d pz = _mm256_sub_pd(_mm256_mul_pd(dx, e2y), _mm256_mul_pd(dy, e2x));
+    __m256d det = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(e1x, px), _mm256_mul_pd(e1y, py)), _mm256_mul_pd(e1z, pz));
+    __m256d inv_det = _mm256_div_pd(_mm256_set1_pd(1.0), det);
+    // s = origin - v0
+    __m256d sx = _mm256_sub_pd(_mm256_set1_pd(ray.point.x), _mm256_load_pd(packet.v0x));
+    __m256d sy = _mm256_sub_pd(_mm256_set1_pd(ray.point.y), _mm256_load_pd(packet.v0y));
+    __m256d sz = _mm256_sub_pd(_mm256_set1_pd(ray.point.z), _mm256_load_pd(packet.v0z));
+    __m256d u = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(sx, px), _mm256_mul_pd(sy, py)), _mm256_mul_pd(sz, pz)), inv_det);
+    // q = s x e1
+    __m256d qx = _mm256_sub_pd(_mm256_mul_pd(sy, e1z), _mm256_mul_pd(sz, e1y));
+    __m256d qy = _mm256_sub_pd(_mm256_mul_pd(sz, e1x), _mm256_mul_pd(sx, e1z));
+    __m256d qz = _mm256_sub_pd(_mm256_mul_pd(sx, e1y), _mm256_mul_pd(sy, e1x));
+    __m256d v = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, qx), _mm256_mul_pd(dy, qy)), _mm256_mul_pd(dz, qz)), inv_det);
+    __m256d t = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(e2x, qx), _mm256_mul_pd(e2y, qy)), _mm256_mul_pd(e2z, qz)), inv_det);
+    // Hit mask
+    __m256d zero = _mm256_setzero_pd();
+    __m256d one = _mm256_set1_pd(1.0);
+    __m256d mask = cull_back_faces ? _mm256_cmp_pd(det, zero, _CMP_GT_OQ) : _mm256_cmp_pd(det, zero, _CMP_NEQ_OQ);
+    mask = _mm256_and_pd(mask, _mm256_cmp_pd(u, zero, _CMP_GE_OQ));
+    mask = _mm256_and_pd(mask, _mm256_cmp_pd(u, one, _CMP_LE_OQ));
+    mask = _mm256_and_pd(mask, _mm256_cmp_pd(v, zero, _CMP_GE_OQ));
+    mask = _mm256_and_pd(mask, _mm256_cmp_pd(_mm256_add_pd(u, v), one, _CMP_LE_OQ));
+    mask = _mm256_and_pd(mask, _mm256_cmp_pd(t, _mm256_set1_pd(t_min), _CMP_GE_OQ));
+    mask = _mm256_and_pd(mask, _mm256_cmp_pd(t, _mm256_set1_pd(t_max), _CMP_LT_OQ));
+    int hits = _mm256_movemask_pd(mask);
+    if (hits == 0) {
+      return -1;
+    }
+    alignas(32) double ts[PACKET_WIDTH];
+    _mm256_store_pd(ts, t);
+    int closest = -1;
+    for (int lane = 0; lane < PACKET_WIDTH; lane++) {
+      if ((hits >> lane & 1) && ts[lane] < t_max) {
+        t_max = ts[lane];
+        closest = lane;
+      }
+    }
+    return closest;
+  }
+#elif defined(__SSE2__)
+  // Two lanes per register, for targets without AVX (SSE2 is part of x86-64)
+  int intersect_packet(const TrianglePacket& packet, const Line3D& ray, double t_min, double& t_max, bool cull_back_faces) {
+    __m128d dx = _mm_set1_pd(ray.direction.x);
+    __m128d dy = _mm_set1_pd(ray.direction.y);
+    __m128d dz = _mm_set1_pd(ray.direction.z);
+    __m128d ox = _mm_set1_pd(ray.point.x);
+    __m128d oy = _mm_set1_pd(ray.point.y);
+    __m128d oz = _mm_set1_pd(ray.point.z);
+    __m128d zero = _mm_setzero_pd();
+    __m128d one = _mm_set1_pd(1.0);
+    __m128d t_lo = _mm_set1_pd(t_min);
+    __m128d t_hi = _mm_set1_pd(t_max);
+    alignas(16) double ts[PACKET_WIDTH];
+    int hits = 0;
+    for (int lane = 0; lane < PACKET_WIDTH; lane += 2) {
+      __m128d e1x = _mm_load_pd(packet.e1x + lane);
+      __m128d e1y = _mm_load_pd(packet.e1y + lane);
+      __m128d e1z = _mm_load_pd(packet.e1z + lane);
+      __m128d e2x = _mm_load_pd(packet.e2x + lane);
+      __m128d e2y = _mm_load_pd(packet.e2y + lane);
+      __m128d e2z = _mm_load_pd(packet.e2z + lane);
+      // p = direction x e2, det = e1 . p
+      __m128d px = _mm_sub_pd(_mm_mul_pd(dy, e2z), _mm_mul_pd(dz, e2y));
+      __m128d py = _mm_sub_pd(_mm_mul_pd(dz, e2x), _mm_mul_pd(dx, e2z));
+      __m128d pz = _mm_sub_pd(_mm_mul_pd(dx, e2y), _mm_mul_pd(dy, e2x));
+      __m128d det = _mm_add_pd(_mm_add_pd(_mm_mul_pd(e1x, px), _mm_mul_pd(e1y, py)), _mm_mul_pd(e1z, pz));
+      __m128d inv_det = _mm_div_pd(one, det);
+      // s = origin - v0
+      __m128d sx = _mm_sub_pd(ox, _mm_load_pd(packet.v0x + lane));
+      __m128d sy = _mm_sub_pd(oy, _mm_load_pd(packet.v0y + lane));
+      __m128d sz = _mm_sub_pd(oz, _mm_load_pd(packet.v0z + lane));
+      __m128d u = _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(sx, px), _mm_mul_pd(sy, py)), _mm_mul_pd(sz, pz)), inv_det);
+      // q = s x e1
+      __m128d qx = _mm_sub_pd(_mm_mul_pd(sy, e1z), _mm_mul_pd(sz, e1y));
+      __m128d qy = _mm_sub_pd(_mm_mul_pd(sz, e1x), _mm_mul_pd(sx, e1z));
+      __m128d qz = _mm_sub_pd(_mm_mul_pd(sx, e1y), _mm_mul_pd(sy, e1x));
+      __m128d v = _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, qx), _mm_mul_pd(dy, qy)), _mm_mul_pd(dz, qz)), inv_det);
+      __m128d t = _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(e2x, qx), _mm_mul_pd(e2y, qy)), _mm_mul_pd(e2z, qz)), inv_det);
+      // Hit mask
+      __m128d mask = cull_back_faces ? _mm_cmpgt_pd(det, zero) : _mm_cmpneq_pd(det, zero);
+      mask = _mm_and_pd(mask, _mm_cmpge_pd(u, zero));
+      mask = _mm_and_pd(mask, _mm_cmple_pd(u, one));
+      mask = _mm_and_pd(mask, _mm_cmpge_pd(v, zero));
+      mask = _mm_and_pd(mask, _mm_cmple_pd(_mm_add_pd(u, v), one));
+      mask = _mm_and_pd(mask, _mm_cmpge_pd(t, t_lo));
+      mask = _mm_and_pd(mask, _mm_cmplt_pd(t, t_hi));
+      hits |= _mm_movemask_pd(mask) << lane;
+      _mm_store_pd(ts + lane, t);
+    }
+    if (hits == 0) {
+      return -1;
+    }
+    int closest = -1;
+    for (int lane = 0; lane < PACKET_WIDTH; lane++) {
+      if ((hits >> lane & 1) && ts[lane] < t_max) {
+        t_max = ts[lane];
+        closest = lane;
+      }
+    }
+    return closest;
+  }
+#else
+  // Same arithmetic lane by lane, written without branches so it can be vectorized
+  int intersect_packet(const TrianglePacket& packet, const Line3D& ray, double t_min, double& t_max, bool cull_back_faces) {
+    double dx = ray.direction.x, dy = ray.direction.y, dz = ray.direction.z;
+    double ts[PACKET_WIDTH];
+    bool hits[PACKET_WIDTH];
+    for (int lane = 0; lane < PACKET_WIDTH; lane++) {
+      double px = dy * packet.e2z[lane] - dz * packet.e2y[lane];
+      double py = dz * packet.e2x[lane] - dx * packet.e2z[lane];
+      double pz = dx * packet.e2y[lane] - dy * packet.e2x[lane];
+      double det = packet.e1x[lane] * px + packet.e1y[lane] * py + packet.e1z[lane] * pz;
+      double inv_det = 1.0 / det;
+      double sx = ray.point.x - packet.v0x[lane];
+      double sy = ray.point.y - packet.v0y[lane];
+      double sz = ray.point.z - packet.v0z[lane];
+      double u = (sx * px + sy * py + sz * pz) * inv_det;
+      double qx = sy * packet.e1z[lane] - sz * packet.e1y[lane];
+      double qy = sz * packet.e1x[lane] - sx * packet.e1z[lane];
+      double qz = sx * packet.e1y[lane] - sy * packet.e1x[lane];
+      double v = (dx * qx + dy * qy + dz * qz) * inv_det;
+      ts[lane] = (packet.e2x[lane] * qx + packet.e2y[lane] * qy + packet.e2z[lane] * qz) * inv_det;
+      bool facing = cull_back_faces ? det > 0 : det != 0;
+      hits[lane] = facing & (u >= 0) & (u <= 1) & (v >= 0) & (u + v <= 1) & (ts[lane] >= t_min) & (ts[lane] < t_max);
+    }
+    int closest = -1;
+    for (int lane = 0; lane < PACKET_WIDTH; lane++) {
+      if (hits[lane] && ts[lane] < t_max) {
+        t_max = ts[lane];
+        closest = lane;
+      }
+    }
+    return closest;
+  }
+#endif
+}
@@ -0,0 +1,33 @@
+#include "3d.h"
+#include "baked.h"
+
+#ifndef MESH_INTERSECT_H
+#define MESH_INTERSECT_H
+
+namespace mesh {
+  // Triangles tested together by intersect_packet
+  const int PACKET_WIDTH = 4;
+
+  // PACKET_WIDTH triangles in structure of arrays layout with the data the
+  // Moller-Trumbore test needs: first vertex and the two edges leaving it.
+  // Unused lanes have zero edges and id -1, they never hit
+  struct alignas(32) TrianglePacket {
+    double v0x[PACKET_WIDTH], v0y[PACKET_WIDTH], v0z[PACKET_WIDTH];
+    double e1x[PACKET_WIDTH], e1y[PACKET_WIDTH], e1z[PACKET_WIDTH];
+    double e2x[PACKET_WIDTH], e2y[PACKET_WIDTH], e2z[PACKET_WIDTH];
+    int id[PACKET_WIDTH];
+    TrianglePacket();
+    void set(int lane, const TriangleRecord& triangle, int id);
+  };
+
+  // One ray against the triangles of a packet, edges count as inside.
+  // Returns the lane of the closest hit with t_min <= t < t_max and lowers
+  // t_max to its t, or -1 when no lane hits. Two sided unless cull_back_faces,
+  // which skips triangles whose e1 x e2 normal points along the ray.
+  // Uses AVX when the compiler targets it (e.g. CXXFLAGS="-O2 -mavx2"), SSE2
+  // otherwise on x86-64 (including the default build) and a portable lane loop
+  // on other targets
+  int intersect_packet(const TrianglePacket& packet, const Line3D& ray, double t_min, double& t_max, bool cull_back_faces = false);
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "mesh.h"
 #include <sstream>
+#include <cmath>
+#include <cstring>
 
 namespace mesh{
   // Transform to generic Vertex3D
@@ -8,135 +10,491 @@ namespace mesh{
   }
 
   // Transform to generic Face3D
-  Face3D Mesh::to_face(const MeshFace& face) {
-    std::vector<Vertex3D> vertices;
-    for (int vertex_id : face.vertices) {
-      vertices.push_back(get_vertex(vertex_id));
+  Face3D Mesh::to_face(int face_index) {
+    return get_face_view(face_index).to_face();
+  }
+
+  void Mesh::push_vertex(const Vertex3D& vertex) {
+    xs.push_back(vertex.x);
+    ys.push_back(vertex.y);
+    zs.push_back(vertex.z);
+  }
+
+  void Mesh::push_face_color(int r, int g, int b) {
+    face_r.push_back(r);
+    face_g.push_back(g);
+    face_b.push_back(b);
+  }
+
+  // Hash exact coordinates. Adding 0.0 turns -0.0 into 0.0 so both hash the same,
+  // matching Vertex3D::operator==
+  std::size_t VertexHash::operator()(const Vertex3D& v) const {
+    std::hash<double> hasher;
+    std::size_t seed = hasher(v.x + 0.0);
+    seed ^= hasher(v.y + 0.0) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    seed ^= hasher(v.z + 0.0) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    return seed;
+  }
+
+  // === Vertex index ===
+  std::size_t Mesh::get_cell_key(long long cx, long long cy, long long cz) {
+    // Large primes spatial hash. Collisions are resolved by the distance check
+    return (std::size_t)(cx * 73856093LL) ^ (std::size_t)(cy * 19349663LL) ^ (std::size_t)(cz * 83492791LL);
+  }
+
+  void Mesh::index_vertex(int vertex_id) {
+    Vertex3D v = get_vertex(vertex_id);
+    if (weld_epsilon > 0) {
+      vertex_grid.emplace(get_cell_key(
+        (long long)std::floor(v.x / weld_epsilon),
+        (long long)std::floor(v.y / weld_epsilon),
+        (long long)std::floor(v.z / weld_epsilon)
+      ), vertex_id);
+    }
+    else {
+      // emplace keeps the first (lowest) id when there are duplicates
+      vertex_index.emplace(v, vertex_id);
+    }
+  }
+
+  void Mesh::unindex_vertex(int vertex_id) {
+    Vertex3D v = get_vertex(vertex_id);
+    if (weld_epsilon > 0) {
+      auto range = vertex_grid.equal_range(get_cell_key(
+        (long long)std::floor(v.x / weld_epsilon),
+        (long long)std::floor(v.y / weld_epsilon),
+        (long long)std::floor(v.z / weld_epsilon)
+      ));
+      for (auto it = range.first; it != range.second; it++) {
+        if (it->second == vertex_id) {
+          vertex_grid.erase(it);
+          return;
+        }
+      }
+    }
+    else {
+      auto it = vertex_index.find(v);
+      if (it != vertex_index.end() && it->second == vertex_id) {
+        vertex_index.erase(it);
+      }
+    }
+  }
+
+  void Mesh::build_vertex_index() {
+    vertex_index.clear();
+    vertex_grid.clear();
+    if (weld_epsilon > 0) {
+      vertex_grid.reserve(xs.size());
+    }
+    else {
+      vertex_index.reserve(xs.size());
     }
-    return Face3D(vertices, face.r, face.g, face.b);
+    for (size_t i = 0; i < xs.size(); i++) {
+      index_vertex(i);
+    }
+    vertex_index_valid = true;
+  }
+
+  // Find a vertex id by position. Returns -1 if not found
+  int Mesh::find_vertex(const Vertex3D& vertex) {
+    if (!vertex_index_valid) {
+      build_vertex_index();
+    }
+    if (weld_epsilon == 0) {
+      auto it = vertex_index.find(vertex);
+      return it == vertex_index.end() ? -1 : it->second;
+    }
+    // Epsilon mode: any vertex within weld_epsilon lies in one of the 27 neighboring cells
+    long long cx = (long long)std::floor(vertex.x / weld_epsilon);
+    long long cy = (long long)std::floor(vertex.y / weld_epsilon);
+    long long cz = (long long)std::floor(vertex.z / weld_epsilon);
+    double max_distance2 = weld_epsilon * weld_epsilon;
+    int found = -1;
+    for (long long dx = -1; dx <= 1; dx++) {
+      for (long long dy = -1; dy <= 1; dy++) {
+        for (long long dz = -1; dz <= 1; dz++) {
+          auto range = vertex_grid.equal_range(get_cell_key(cx + dx, cy + dy, cz + dz));
+          for (auto it = range.first; it != range.second; it++) {
+            Vertex3D diff = get_vertex(it->second) - vertex;
+            double distance2 = dot_product(diff, diff);
+            // Keep the lowest id so welding does not depend on hash order
+            if (distance2 <= max_distance2 && (found == -1 || it->second < found)) {
+              found = it->second;
+            }
+          }
+        }
+      }
+    }
+    return found;
+  }
+
+  void Mesh::invalidate_vertex_index() {
+    vertex_index_valid = false;
+    vertex_index.clear();
+    vertex_grid.clear();
+  }
+
+  // Change the welding tolerance. 0 means exact matching
+  void Mesh::set_weld_epsilon(double epsilon) {
+    weld_epsilon = epsilon > 0 ? epsilon : 0;
+    invalidate_vertex_index();
+  }
+
+  double Mesh::get_weld_epsilon() {
+    return weld_epsilon;
   }
 
   // Insert vertex into mesh
   int Mesh::insert_vertex(const Vertex3D& vertex) {
-    // Searcg for the vertex
-    auto it = std::find(vertices.begin(), vertices.end(), vertex);
-    if (it == vertices.end()) {
+    // Compare at the stored precision
+    Vertex3D stored((MeshReal) vertex.x, (MeshReal) vertex.y, (MeshReal) vertex.z);
+    // Search for the vertex
+    int vertex_id = find_vertex(stored);
+    if (vertex_id == -1) {
       // If the vertex is not found, add it
-      vertices.push_back(vertex);
-      return vertices.size() - 1;
-    }
-    else {
-      return it - vertices.begin();
+      push_vertex(stored);
+      vertex_id = xs.size() - 1;
+      index_vertex(vertex_id);
     }
+    return vertex_id;
   }
 
   // Insert face into mesh
   int Mesh::insert_face(const Face3D& face) {
-    MeshFace mesh_face;
-    for (Vertex3D vertex : face.vertices) {
+    for (const Vertex3D& vertex : face.vertices) {
       int vertex_id = insert_vertex(vertex);
-      mesh_face.vertices.push_back(vertex_id);
+      face_indices.push_back(vertex_id);
     }
-    mesh_face.r = face.r;
-    mesh_face.g = face.g;
-    mesh_face.b = face.b;
-    faces.push_back(mesh_face);
-    return faces.size() - 1;
+    face_offsets.push_back(face_indices.size());
+    push_face_color(face.r, face.g, face.b);
+    int face_id = get_face_count() - 1;
+    if (adjacency_valid) {
+      add_face_half_edges(face_id);
+    }
+    return face_id;
   }
 
   // Constructor from generic Face3D
-  Mesh::Mesh(const std::vector<Face3D>& faces) {
-    for (Face3D face : faces) {
+  Mesh::Mesh(const std::vector<Face3D>& faces, double weld_epsilon) {
+    set_weld_epsilon(weld_epsilon);
+    face_offsets.reserve(faces.size() + 1);
+    for (const Face3D& face : faces) {
       insert_face(face);
     }
   }
 
+  // Constructor from indexed data. Face f uses the vertex ids
+  // face_indices[face_offsets[f]] .. face_indices[face_offsets[f + 1] - 1]
+  Mesh::Mesh(const std::vector<Vertex3D>& vertices, std::vector<int> face_offsets, std::vector<int> face_indices) :
+    face_offsets(std::move(face_offsets)),
+    face_indices(std::move(face_indices)) {
+    if (this->face_offsets.empty()) {
+      this->face_offsets.push_back(0);
+    }
+    xs.reserve(vertices.size());
+    ys.reserve(vertices.size());
+    zs.reserve(vertices.size());
+    for (const Vertex3D& vertex : vertices) {
+      push_vertex(vertex);
+    }
+    int face_count = get_face_count();
+    face_r.assign(face_count, 0);
+    face_g.assign(face_count, 0);
+    face_b.assign(face_count, 0);
+  }
+
+  // === PLY format ===
+  template <typename T>
+  static double read_binary(std::istream& file) {
+    // Zero when the read comes up short, callers check the stream
+    T value{};
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return (double) from_little_endian(value);
+  }
+
+  // Read a single value of the given type
+  static double read_ply_value(std::istream& file, PlyType type, PlyFormat format) {
+    if (format == PLY_ASCII) {
+      double value = 0;
+      file >> value;
+      return value;
+    }
+    switch (type) {
+      case PLY_CHAR: return read_binary<std::int8_t>(file);
+      case PLY_UCHAR: return read_binary<std::uint8_t>(file);
+      case PLY_SHORT: return read_binary<std::int16_t>(file);
+      case PLY_USHORT: return read_binary<std::uint16_t>(file);
+      case PLY_INT: return read_binary<std::int32_t>(file);
+      case PLY_UINT: return read_binary<std::uint32_t>(file);
+      case PLY_FLOAT: return read_binary<float>(file);
+      case PLY_DOUBLE: return read_binary<double>(file);
+      default: return 0;
+    }
+  }
+
   // Constructor from PLY file
-  Mesh::Mesh(const std::string& filename) {
+  Mesh::Mesh(const std::string& filename, PlyLoader loader) {
+    if (loader == PLY_LOAD_STREAM) {
+      load_ply_stream(filename);
+    }
+    else {
+      load_ply_mapped(filename);
+    }
+  }
 
+  // Parse the file in place from a read-only mapping
+  void Mesh::load_ply_mapped(const std::string& filename) {
+    MappedFile file(filename);
+    if (!file.is_open()) {
+      std::cerr << "Could not open PLY file: " << filename << std::endl;
+      return;
+    }
+    const char* cursor = file.begin();
+    const char* end = file.end();
+    PlyHeader header;
+    if (!parse_ply_header(cursor, end, header)) {
+      return;
+    }
+    for (const PlyElement& element : header.elements) {
+      bool is_vertex = element.name == "vertex";
+      bool is_face = element.name == "face";
+      // Binary x/y/z of the same float type: read the packed records directly
+      bool raw_vertices = is_vertex
+        && header.format == PLY_BINARY_LITTLE_ENDIAN
+        && element.properties.size() == 3
+        && element.properties[0].name == "x" && !element.properties[0].is_list
+        && element.properties[1].name == "y" && !element.properties[1].is_list
+        && element.properties[2].name == "z" && !element.properties[2].is_list
+        && (element.properties[0].type == PLY_DOUBLE || element.properties[0].type == PLY_FLOAT)
+        && element.properties[1].type == element.properties[0].type
+        && element.properties[2].type == element.properties[0].type;
+      if (is_vertex) {
+        xs.reserve(xs.size() + element.count);
+        ys.reserve(ys.size() + element.count);
+        zs.reserve(zs.size() + element.count);
+      }
+      if (raw_vertices) {
+        bool is_double = element.properties[0].type == PLY_DOUBLE;
+        size_t stride = is_double ? 3 * sizeof(double) : 3 * sizeof(float);
+        if ((size_t)(end - cursor) < (size_t) element.count * stride) {
+          std::cerr << "Unexpected end of PLY file" << std::endl;
+          return;
+        }
+        for (int i = 0; i < element.count; i++, cursor += stride) {
+          if (is_double) {
+            double xyz[3];
+            std::memcpy(xyz, cursor, sizeof(xyz));
+            push_vertex(Vertex3D(from_little_endian(xyz[0]), from_little_endian(xyz[1]), from_little_endian(xyz[2])));
+          }
+          else {
+            float xyz[3];
+            std::memcpy(xyz, cursor, sizeof(xyz));
+            push_vertex(Vertex3D(from_little_endian(xyz[0]), from_little_endian(xyz[1]), from_little_endian(xyz[2])));
+          }
+        }
+        continue;
+      }
+      if (is_face) {
+        face_offsets.reserve(face_offsets.size() + element.count);
+        face_indices.reserve(face_indices.size() + (size_t) element.count * 3);
+      }
+      // Resolve what each property feeds once, not per value
+      enum { SKIP, X, Y, Z, RED, GREEN, BLUE, INDEXES };
+      std::vector<int> roles;
+      for (const PlyProperty& property : element.properties) {
+        int role = SKIP;
+        if (is_vertex && !property.is_list) {
+          if (property.name == "x") role = X;
+          else if (property.name == "y") role = Y;
+          else if (property.name == "z") role = Z;
+        }
+        else if (is_face && !property.is_list) {
+          if (property.name == "red") role = RED;
+          else if (property.name == "green") role = GREEN;
+          else if (property.name == "blue") role = BLUE;
+        }
+        else if (is_face && (property.name == "vertex_indices" || property.name == "vertex_index")) {
+          role = INDEXES;
+        }
+        roles.push_back(role);
+      }
+      for (int i = 0; i < element.count; i++) {
+        Vertex3D vertex;
+        // Default color
+        int r = 255, g = 255, b = 255;
+        for (size_t p = 0; p < element.properties.size(); p++) {
+          const PlyProperty& property = element.properties[p];
+          double value;
+          if (property.is_list) {
+            if (!parse_ply_value(cursor, end, property.count_type, header.format, value)) {
+              std::cerr << "Unexpected end of PLY file" << std::endl;
+              return;
+            }
+            int count = (int) value;
+            if (count < 0) {
+              std::cerr << "Invalid PLY list size: " << count << std::endl;
+              return;
+            }
+            for (int j = 0; j < count; j++) {
+              if (!parse_ply_value(cursor, end, property.type, header.format, value)) {
+                std::cerr << "Unexpected end of PLY file" << std::endl;
+                return;
+              }
+              if (roles[p] == INDEXES) {
+                face_indices.push_back((int) value);
+              }
+            }
+            continue;
+          }
+          if (!parse_ply_value(cursor, end, property.type, header.format, value)) {
+            std::cerr << "Unexpected end of PLY file" << std::endl;
+            return;
+          }
+          switch (roles[p]) {
+            case X: vertex.x = value; break;
+            case Y: vertex.y = value; break;
+            case Z: vertex.z = value; break;
+            case RED: r = (int) value; break;
+            case GREEN: g = (int) value; break;
+            case BLUE: b = (int) value; break;
+            default: break;
+          }
+        }
+        if (is_vertex) {
+          push_vertex(vertex);
+        }
+        else if (is_face) {
+          face_offsets.push_back(face_indices.size());
+          push_face_color(r, g, b);
+        }
+      }
+    }
+  }
+
+  // Parse the file through std::ifstream and operator>>
+  void Mesh::load_ply_stream(const std::string& filename) {
     std::ifstream file;
-    file.open(filename);
+    file.open(filename, std::ios::binary);
     std::string line;
     // Read header
     std::getline(file, line);
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
     if (line != "ply") {
       std::cerr << "Invalid PLY file" << std::endl;
       return;
     }
     std::getline(file, line);
-    if (line != "format ascii 1.0") {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    PlyFormat format;
+    if (line == "format ascii 1.0") {
+      format = PLY_ASCII;
+    }
+    else if (line == "format binary_little_endian 1.0") {
+      format = PLY_BINARY_LITTLE_ENDIAN;
+    }
+    else {
       std::cerr << "Invalid PLY fileformat" << std::endl;
       return;
     }
     // Elements
-    std::vector<std::string> elements;
-    std::map<std::string, int> element_count;
+    std::vector<PlyElement> elements;
     std::getline(file, line);
-    std::string current_element = "";
-    while (line != "end_header"){
+    while (file && line.rfind("end_header", 0) != 0){
       // Split line by spaces
       std::istringstream iss(line);
-      std::string t1, t2, t3;
-      iss >> t1 >> t2 >> t3;
+      std::string t1, t2, t3, t4, t5;
+      iss >> t1 >> t2 >> t3 >> t4 >> t5;
       // Determine input
       if (t1 == "element"){
         // Read element
-        current_element = t2;
-        auto current_count = std::stoi(t3);
-        elements.push_back(current_element);
-        element_count[current_element] = current_count;
+        PlyElement element;
+        element.name = t2;
+        element.count = std::stoi(t3);
+        elements.push_back(element);
       }
-      else if (t1 == "property"){
-        // skip
+      else if (t1 == "property" && !elements.empty()){
+        PlyProperty property;
+        if (t2 == "list") {
+          // property list <count type> <item type> <name>
+          property.is_list = true;
+          property.count_type = get_ply_type(t3);
+          property.type = get_ply_type(t4);
+          property.name = t5;
+        }
+        else {
+          property.is_list = false;
+          property.count_type = PLY_INVALID;
+          property.type = get_ply_type(t2);
+          property.name = t3;
+        }
+        if (property.type == PLY_INVALID || (property.is_list && property.count_type == PLY_INVALID)) {
+          std::cerr << "Invalid PLY property: " << line << std::endl;
+          return;
+        }
+        elements.back().properties.push_back(property);
       }
       // Read next line
       std::getline(file, line);
-    } 
-    // Read vertices
-    for (auto element : elements){
-      if (element == "vertex"){
-        for (int i = 0; i < element_count[element]; i++){
-          std::getline(file, line);
-          std::istringstream iss(line);
-          double x, y, z;
-          iss >> x >> y >> z;
-          vertices.push_back(Vertex3D(x, y, z));
-        }
-      }
-      else if (element == "face"){
-        for (int i = 0; i < element_count[element]; i++){
-          std::getline(file, line);
-          std::istringstream iss(line);
-          int vertex_count;
-          iss >> vertex_count;
-          std::vector<int> vertex_ids;
-          for (int j = 0; j < vertex_count; j++){
-            int vertex_id;
-            iss >> vertex_id;
-            vertex_ids.push_back(vertex_id);
+    }
+    // Read elements in the declared order
+    for (const PlyElement& element : elements){
+      bool is_vertex = element.name == "vertex";
+      bool is_face = element.name == "face";
+      for (int i = 0; i < element.count; i++){
+        Vertex3D vertex;
+        // Default color
+        int r = 255, g = 255, b = 255;
+        for (const PlyProperty& property : element.properties){
+          if (property.is_list) {
+            int count = (int) read_ply_value(file, property.count_type, format);
+            if (!file) {
+              std::cerr << "Unexpected end of PLY file" << std::endl;
+              return;
+            }
+            if (count < 0) {
+              std::cerr << "Invalid PLY list size: " << count << std::endl;
+              return;
+            }
+            bool is_index_list = is_face && (property.name == "vertex_indices" || property.name == "vertex_index");
+            for (int j = 0; j < count; j++) {
+              double value = read_ply_value(file, property.type, format);
+              // A count larger than the rest of the file stops here
+              if (!file) {
+                std::cerr << "Unexpected end of PLY file" << std::endl;
+                return;
+              }
+              if (is_index_list) {
+                face_indices.push_back((int) value);
+              }
+            }
+            continue;
           }
-          // If iss is not empty, read color
-          int r, g, b;
-          if (iss >> r >> g >> b){}
-          else {
-            // Default color
-            r = 255;
-            g = 255;
-            b = 255;
+          double value = read_ply_value(file, property.type, format);
+          if (is_vertex) {
+            if (property.name == "x") vertex.x = value;
+            else if (property.name == "y") vertex.y = value;
+            else if (property.name == "z") vertex.z = value;
+          }
+          else if (is_face) {
+            if (property.name == "red") r = (int) value;
+            else if (property.name == "green") g = (int) value;
+            else if (property.name == "blue") b = (int) value;
           }
-          // Create face
-          MeshFace face;
-          face.vertices = vertex_ids;
-          face.r = r;
-          face.g = g;
-          face.b = b;
-          faces.push_back(face);
         }
-      }
-      else {
-        // Skip element
-        for (int i = 0; i < element_count[element]; i++){
-          std::getline(file, line);
+        if (!file) {
+          std::cerr << "Unexpected end of PLY file" << std::endl;
+          return;
+        }
+        if (is_vertex) {
+          push_vertex(vertex);
+        }
+        else if (is_face) {
+          face_offsets.push_back(face_indices.size());
+          push_face_color(r, g, b);
         }
       }
     }
@@ -146,6 +504,11 @@ namespace mesh{
 
   // Generic getter for vertices
   std::vector<Vertex3D> Mesh::get_vertices() {
+    std::vector<Vertex3D> vertices;
+    vertices.reserve(xs.size());
+    for (size_t i = 0; i < xs.size(); i++) {
+      vertices.push_back(Vertex3D(xs[i], ys[i], zs[i]));
+    }
     return vertices;
   }
   
@@ -153,70 +516,375 @@ namespace mesh{
   std::vector<Face3D> Mesh::get_faces() {
     // From faces to Face3D
     std::vector<Face3D> face3d_faces;
-    for (size_t i = 0; i < faces.size(); i++) {
+    face3d_faces.reserve(get_face_count());
+    for (int i = 0; i < get_face_count(); i++) {
       face3d_faces.push_back(get_face(i));
     }
     return face3d_faces;
   }
 
   Vertex3D Mesh::get_vertex(int index) {
-    return vertices[index];
+    return Vertex3D(xs[index], ys[index], zs[index]);
   }
 
   Face3D Mesh::get_face(int index) {
-    return to_face(faces[index]);
+    return to_face(index);
+  }
+
+  FaceView Mesh::get_face_view(int index) {
+    return FaceView{
+      index,
+      get_face_vertex_ids(index),
+      xs.data(), ys.data(), zs.data(),
+      face_r[index], face_g[index], face_b[index]
+    };
+  }
+
+  FaceRange Mesh::get_face_views() {
+    return FaceRange{this, get_face_count()};
+  }
+
+  FaceView FaceRange::iterator::operator*() const {
+    return mesh->get_face_view(index);
+  }
+
+  // === Face views ===
+  Vertex3D FaceView::get_midpoint() const {
+    double x = 0, y = 0, z = 0;
+    for (int vertex_id : vertex_ids) {
+      x += xs[vertex_id];
+      y += ys[vertex_id];
+      z += zs[vertex_id];
+    }
+    int n = size();
+    return Vertex3D(x / n, y / n, z / n);
+  }
+
+  Vertex3D FaceView::get_normal() const {
+    Vertex3D v1 = vertex(0);
+    return cross_product(vertex(1) - v1, vertex(2) - v1).normalized();
+  }
+
+  // Same test as Face3D::intersect, reading the vertices in place
+  std::optional<Vertex3D> FaceView::intersect(const Line3D& l1) const {
+    Vertex3D normal = get_normal();
+    auto intersection = intersect_lp(l1, Plane3D(vertex(0), normal));
+    // If no value return nullopt
+    if (!intersection.has_value()) {
+      return std::nullopt;
+    }
+    // Crossproduct must have the same sign as normal
+    Vertex3D intersection_point = intersection.value();
+    int n = size();
+    for (int i = 0; i < n; i++) {
+      Vertex3D v1 = vertex(i);
+      Vertex3D v2 = vertex((i + 1) % n);
+      Vertex3D edge_normal = cross_product(v2 - v1, intersection_point - v1);
+      if (dot_product(edge_normal, normal) < 0) {
+        return std::nullopt;
+      }
+    }
+    return intersection;
+  }
+
+  Face3D FaceView::to_face() const {
+    std::vector<Vertex3D> vertices;
+    vertices.reserve(size());
+    for (int i = 0; i < size(); i++) {
+      vertices.push_back(vertex(i));
+    }
+    return Face3D(vertices, r, g, b);
+  }
+
+  int Mesh::get_vertex_count() {
+    return xs.size();
+  }
+
+  int Mesh::get_face_count() {
+    return face_offsets.size() - 1;
+  }
+
+  IndexSpan Mesh::get_face_vertex_ids(int index) {
+    return IndexSpan{
+      face_indices.data() + face_offsets[index],
+      face_indices.data() + face_offsets[index + 1]
+    };
+  }
+
+  const std::vector<int>& Mesh::get_face_offsets() {
+    return face_offsets;
+  }
+
+  const std::vector<int>& Mesh::get_face_indices() {
+    return face_indices;
+  }
+
+  const std::vector<MeshReal>& Mesh::get_xs() {
+    return xs;
+  }
+
+  const std::vector<MeshReal>& Mesh::get_ys() {
+    return ys;
+  }
+
+  const std::vector<MeshReal>& Mesh::get_zs() {
+    return zs;
   }
 
   // === To PLY ===
-  std::string Mesh::get_header() {
-    return "ply\nformat ascii 1.0\nelement vertex " + std::to_string(vertices.size()) + "\nproperty double x\nproperty double y\nproperty double z\nelement face " + std::to_string(faces.size()) + "\nproperty list uchar int vertex_index\nproperty uchar red\nproperty uchar green\nproperty uchar blue\nend_header\n";
+  std::string Mesh::get_header(PlyFormat format) {
+    std::string format_name = format == PLY_ASCII ? "ascii" : "binary_little_endian";
+    std::string real_name = sizeof(MeshReal) == sizeof(float) ? "float" : "double";
+    return "ply\nformat " + format_name + " 1.0\nelement vertex " + std::to_string(xs.size()) + "\nproperty " + real_name + " x\nproperty " + real_name + " y\nproperty " + real_name + " z\nelement face " + std::to_string(get_face_count()) + "\nproperty list uchar int vertex_index\nproperty uchar red\nproperty uchar green\nproperty uchar blue\nend_header\n";
   }
 
-  std::string Mesh::get_vertex_string() {
-    std::string vertex_string = "";
-    for (Vertex3D vertex : vertices) {
-      vertex_string += std::to_string(vertex.x) + " " + std::to_string(vertex.y) + " " + std::to_string(vertex.z) + "\n";
+  void Mesh::write_vertices(PlyWriter& writer, PlyFormat format) {
+    for (size_t i = 0; i < xs.size(); i++) {
+      if (format == PLY_ASCII) {
+        writer.write_double(xs[i]);
+        writer.write_char(' ');
+        writer.write_double(ys[i]);
+        writer.write_char(' ');
+        writer.write_double(zs[i]);
+        writer.write_char('\n');
+      }
+      else {
+        writer.write_binary<MeshReal>(xs[i]);
+        writer.write_binary<MeshReal>(ys[i]);
+        writer.write_binary<MeshReal>(zs[i]);
+      }
     }
-    return vertex_string;
   }
 
-  std::string Mesh::get_face_string() {
-    std::string face_string = "";
-    for (MeshFace face : faces) {
-      face_string += std::to_string(face.vertices.size()) + " ";
-      for (int vertex_id : face.vertices) {
-        face_string += std::to_string(vertex_id) + " ";
+  void Mesh::write_faces(PlyWriter& writer, PlyFormat format) {
+    for (int f = 0; f < get_face_count(); f++) {
+      IndexSpan ids = get_face_vertex_ids(f);
+      if (format == PLY_ASCII) {
+        writer.write_int(ids.size());
+        writer.write_char(' ');
+        for (int vertex_id : ids) {
+          writer.write_int(vertex_id);
+          writer.write_char(' ');
+        }
+        // RGB data
+        writer.write_int(face_r[f]);
+        writer.write_char(' ');
+        writer.write_int(face_g[f]);
+        writer.write_char(' ');
+        writer.write_int(face_b[f]);
+        writer.write_char('\n');
+      }
+      else {
+        writer.write_binary<std::uint8_t>(ids.size());
+        for (int vertex_id : ids) {
+          writer.write_binary<std::int32_t>(vertex_id);
+        }
+        writer.write_binary<std::uint8_t>(face_r[f]);
+        writer.write_binary<std::uint8_t>(face_g[f]);
+        writer.write_binary<std::uint8_t>(face_b[f]);
       }
-      // RGB data
-      face_string += std::to_string(face.r) + " " + std::to_string(face.g) + " " + std::to_string(face.b);
-      face_string += "\n";
     }
-    return face_string;
   }
 
-  void Mesh::save_ply(const char* filename) {
-    std::ofstream file;
-    file.open(filename);
-    file << get_header();
-    file << get_vertex_string();
-    file << get_face_string();
-    file.close();
+  // Streams the mesh to disk: memory use is bounded by the writer buffer
+  void Mesh::save_ply(const char* filename, PlyFormat format) {
+    PlyWriter writer(filename);
+    if (!writer.is_open()) {
+      std::cerr << "Could not open PLY file: " << filename << std::endl;
+      return;
+    }
+    writer.write(get_header(format));
+    write_vertices(writer, format);
+    write_faces(writer, format);
+  }
+
+  // === Connectivity ===
+  std::uint64_t Mesh::get_edge_key(int v1, int v2) {
+    if (v1 > v2) {
+      std::swap(v1, v2);
+    }
+    return ((std::uint64_t)(std::uint32_t)v1 << 32) | (std::uint32_t)v2;
+  }
+
+  // Append the half-edges of a face and pair them with the ones already in the mesh
+  void Mesh::add_face_half_edges(int face_id) {
+    IndexSpan face_vertices = get_face_vertex_ids(face_id);
+    int n = face_vertices.size();
+    // Half-edge ids match the positions in face_indices
+    int first = half_edges.size();
+    face_half_edge.push_back(n > 0 ? first : -1);
+    if (vertex_half_edge.size() < xs.size()) {
+      vertex_half_edge.resize(xs.size(), -1);
+    }
+    for (int i = 0; i < n; i++) {
+      int h = first + i;
+      int origin = face_vertices[i];
+      int destination = face_vertices[(i + 1) % n];
+      HalfEdge half_edge;
+      half_edge.origin = origin;
+      half_edge.face = face_id;
+      half_edge.next = first + (i + 1) % n;
+      half_edge.prev = first + (i + n - 1) % n;
+      half_edge.twin = -1;
+      half_edges.push_back(half_edge);
+      edge_next.push_back(-1);
+      if (vertex_half_edge[origin] == -1) {
+        vertex_half_edge[origin] = h;
+      }
+      // Pair with the first half-edge on the same edge.
+      // On non-manifold edges the extra half-edges stay unpaired but chained
+      auto inserted = edge_half_edge.emplace(get_edge_key(origin, destination), h);
+      if (!inserted.second) {
+        int other = inserted.first->second;
+        if (half_edges[other].twin == -1) {
+          half_edges[other].twin = h;
+          half_edges[h].twin = other;
+        }
+        while (edge_next[other] != -1) {
+          other = edge_next[other];
+        }
+        edge_next[other] = h;
+      }
+    }
+  }
+
+  void Mesh::build_adjacency() {
+    half_edges.clear();
+    edge_next.clear();
+    face_half_edge.clear();
+    vertex_half_edge.assign(xs.size(), -1);
+    edge_half_edge.clear();
+    size_t half_edge_count = face_indices.size();
+    half_edges.reserve(half_edge_count);
+    edge_next.reserve(half_edge_count);
+    face_half_edge.reserve(get_face_count());
+    edge_half_edge.reserve(half_edge_count / 2 + 1);
+    for (int i = 0; i < get_face_count(); i++) {
+      add_face_half_edges(i);
+    }
+    adjacency_valid = true;
+  }
+
+  const std::vector<HalfEdge>& Mesh::get_half_edges() {
+    if (!adjacency_valid) {
+      build_adjacency();
+    }
+    return half_edges;
+  }
+
+  // Half-edge on the edge v1-v2 (either direction). -1 if there is no such edge
+  int Mesh::get_half_edge(int v1, int v2) {
+    if (!adjacency_valid) {
+      build_adjacency();
+    }
+    auto it = edge_half_edge.find(get_edge_key(v1, v2));
+    return it == edge_half_edge.end() ? -1 : it->second;
+  }
+
+  // Faces sharing the edge v1-v2, in insertion order
+  std::vector<int> Mesh::get_edge_faces(int v1, int v2) {
+    std::vector<int> edge_faces;
+    int h = get_half_edge(v1, v2);
+    if (h == -1) {
+      return edge_faces;
+    }
+    for (; h != -1; h = edge_next[h]) {
+      edge_faces.push_back(half_edges[h].face);
+    }
+    return edge_faces;
+  }
+
+  bool Mesh::is_boundary_edge(int v1, int v2) {
+    int h = get_half_edge(v1, v2);
+    return h != -1 && half_edges[h].twin == -1;
+  }
+
+  std::vector<std::pair<int, int>> Mesh::get_boundary_edges() {
+    if (!adjacency_valid) {
+      build_adjacency();
+    }
+    std::vector<std::pair<int, int>> boundary;
+    for (int h = 0; h < (int)half_edges.size(); h++) {
+      const HalfEdge& half_edge = half_edges[h];
+      // Only the first half-edge of an edge can be a boundary. Unpaired ones
+      // after the second on a non-manifold edge have other faces in the chain
+      if (half_edge.twin == -1 && get_half_edge(half_edge.origin, half_edges[half_edge.next].origin) == h) {
+        boundary.push_back({half_edge.origin, half_edges[half_edge.next].origin});
+      }
+    }
+    return boundary;
+  }
+
+  // Outgoing half-edges of a vertex, in rotation order.
+  // Assumes the faces around the vertex are consistently oriented
+  std::vector<int> Mesh::get_vertex_half_edges(int vertex_id) {
+    if (!adjacency_valid) {
+      build_adjacency();
+    }
+    std::vector<int> outgoing;
+    if (vertex_id < 0 || vertex_id >= (int)vertex_half_edge.size() || vertex_half_edge[vertex_id] == -1) {
+      return outgoing;
+    }
+    int start = vertex_half_edge[vertex_id];
+    // Rotate: the twin of the previous half-edge leaves the vertex again
+    int h = start;
+    do {
+      outgoing.push_back(h);
+      h = half_edges[half_edges[h].prev].twin;
+    } while (h != -1 && h != start && half_edges[h].origin == vertex_id && outgoing.size() < half_edges.size());
+    if (h == start) {
+      return outgoing;
+    }
+    // Boundary reached: rotate the other way from start
+    std::vector<int> backwards;
+    int twin = half_edges[start].twin;
+    while (twin != -1 && backwards.size() < half_edges.size()) {
+      h = half_edges[twin].next;
+      if (half_edges[h].origin != vertex_id) {
+        break;
+      }
+      backwards.push_back(h);
+      twin = half_edges[h].twin;
+    }
+    outgoing.insert(outgoing.begin(), backwards.rbegin(), backwards.rend());
+    return outgoing;
+  }
+
+  // One-ring of a vertex
+  std::vector<int> Mesh::get_vertex_neighbors(int vertex_id) {
+    std::vector<int> neighbors;
+    std::vector<int> outgoing = get_vertex_half_edges(vertex_id);
+    for (int h : outgoing) {
+      neighbors.push_back(half_edges[half_edges[h].next].origin);
+    }
+    // On the boundary the last face also reaches a vertex through its incoming edge
+    if (!outgoing.empty()) {
+      const HalfEdge& incoming = half_edges[half_edges[outgoing.back()].prev];
+      if (incoming.twin == -1) {
+        neighbors.push_back(incoming.origin);
+      }
+    }
+    return neighbors;
+  }
+
+  std::vector<int> Mesh::get_vertex_faces(int vertex_id) {
+    std::vector<int> vertex_faces;
+    for (int h : get_vertex_half_edges(vertex_id)) {
+      vertex_faces.push_back(half_edges[h].face);
+    }
+    return vertex_faces;
   }
 
   // === Query ===
   std::vector<Face3D> Mesh::get_faces_with_edge(const Edge3D& edge) {
     std::vector<Face3D> faces_with_edge;
-    for (MeshFace face : faces) {
-      for (int i = 0; i < face.vertices.size(); i++) {
-        Vertex3D v1 = get_vertex(face.vertices[i]);
-        Vertex3D v2 = get_vertex(face.vertices[(i + 1) % face.vertices.size()]);
-        Edge3D forward_edge = Edge3D(v1, v2);
-        Edge3D reversed_edge = forward_edge.reversed();
-        if (forward_edge == edge || reversed_edge == edge) {
-          faces_with_edge.push_back( to_face(face) );
-          break;
-        }
-      }
+    int v1 = find_vertex(edge.v1);
+    int v2 = find_vertex(edge.v2);
+    if (v1 == -1 || v2 == -1) {
+      return faces_with_edge;
+    }
+    for (int face_id : get_edge_faces(v1, v2)) {
+      faces_with_edge.push_back( to_face(face_id) );
     }
     return faces_with_edge;
   }
@@ -224,18 +892,65 @@ namespace mesh{
   // Modify mesh
   void Mesh::move_point(const Vertex3D& point, const Vertex3D& target) {
     // Search for the point
-    auto it = std::find(vertices.begin(), vertices.end(), point);
-    if (it != vertices.end()) {
+    int vertex_id = find_vertex(point);
+    if (vertex_id != -1) {
       // If the point is found, move it
-      *it = target;
+      unindex_vertex(vertex_id);
+      xs[vertex_id] = target.x;
+      ys[vertex_id] = target.y;
+      zs[vertex_id] = target.z;
+      index_vertex(vertex_id);
     }
   }
 
-  // Displace
+  // Displace. One flat loop per coordinate so the compiler can vectorize it
   void Mesh::displace(const Vertex3D& v) {
-    for (Vertex3D& vertex : vertices) {
-      vertex = vertex + v;
+    MeshReal dx = v.x, dy = v.y, dz = v.z;
+    for (MeshReal& x : xs) {
+      x += dx;
+    }
+    for (MeshReal& y : ys) {
+      y += dy;
+    }
+    for (MeshReal& z : zs) {
+      z += dz;
+    }
+    // Positions changed: rebuild the index on next lookup
+    invalidate_vertex_index();
+  }
+
+  Vertex3D Mesh::get_face_midpoint(int face_index) {
+    double x = 0, y = 0, z = 0;
+    IndexSpan ids = get_face_vertex_ids(face_index);
+    for (int vertex_id : ids) {
+      x += xs[vertex_id];
+      y += ys[vertex_id];
+      z += zs[vertex_id];
+    }
+    return Vertex3D(x / ids.size(), y / ids.size(), z / ids.size());
+  }
+
+  // Unit normal of every face, from its first three vertices like Face3D::get_normal.
+  // Zero for faces with fewer than three vertices or collinear first three
+  std::vector<Vertex3D> Mesh::get_face_normals() {
+    int face_count = get_face_count();
+    std::vector<Vertex3D> normals(face_count, Vertex3D(0, 0, 0));
+    for (int f = 0; f < face_count; f++) {
+      if (face_offsets[f + 1] - face_offsets[f] < 3) {
+        continue;
+      }
+      const int* ids = face_indices.data() + face_offsets[f];
+      double ax = xs[ids[1]] - xs[ids[0]], ay = ys[ids[1]] - ys[ids[0]], az = zs[ids[1]] - zs[ids[0]];
+      double bx = xs[ids[2]] - xs[ids[0]], by = ys[ids[2]] - ys[ids[0]], bz = zs[ids[2]] - zs[ids[0]];
+      double nx = ay * bz - az * by;
+      double ny = az * bx - ax * bz;
+      double nz = ax * by - ay * bx;
+      double norm = std::sqrt(nx * nx + ny * ny + nz * nz);
+      if (norm > 0) {
+        normals[f] = Vertex3D(nx / norm, ny / norm, nz / norm);
+      }
     }
+    return normals;
   }
 
 }
\ No newline at end of file
@@ -4,7 +4,10 @@
 #include <string>
 #include <algorithm>
 #include <map>
+#include <unordered_map>
+#include <cstdint>
 #include "3d.h"
+#include "ply.h"
 
 #ifndef MESH_STRUCTURE_H
 #define MESH_STRUCTURE_H
@@ -13,38 +16,174 @@
 
 namespace mesh{ 
   // MESH
+  // Scalar type of the stored positions. Define MESH_FLOAT_POSITIONS to halve
+  // the memory used by large meshes
+#ifdef MESH_FLOAT_POSITIONS
+  using MeshReal = float;
+#else
+  using MeshReal = double;
+#endif
   using MeshVertex = Vertex3D;
-  struct MeshFace {
-    std::vector<int> vertices;
+
+  // Non-owning view over a range of vertex ids
+  struct IndexSpan {
+    const int* first;
+    const int* last;
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return last - first; }
+    int operator[](int i) const { return first[i]; }
+  };
+
+  // Non-owning view of a face of a Mesh. Vertices are read from the mesh
+  // storage on demand, so iterating faces does not allocate.
+  // Views are invalidated when the mesh vertex or face arrays grow
+  struct FaceView {
+    int index;
+    IndexSpan vertex_ids;
+    const MeshReal* xs;
+    const MeshReal* ys;
+    const MeshReal* zs;
     int r, g, b;
+    int size() const { return vertex_ids.size(); }
+    bool is_triangle() const { return vertex_ids.size() == 3; }
+    Vertex3D vertex(int i) const {
+      int id = vertex_ids[i];
+      return Vertex3D(xs[id], ys[id], zs[id]);
+    }
+    Vertex3D get_midpoint() const;
+    Vertex3D get_normal() const;
+    std::optional<Vertex3D> intersect(const Line3D& l1) const;
+    Face3D to_face() const;
+  };
+
+  class Mesh;
+
+  // Iterable range over the faces of a mesh, yielding FaceView
+  struct FaceRange {
+    struct iterator {
+      Mesh* mesh;
+      int index;
+      FaceView operator*() const;
+      iterator& operator++() { index++; return *this; }
+      bool operator!=(const iterator& other) const { return index != other.index; }
+    };
+    Mesh* mesh;
+    int count;
+    iterator begin() const { return iterator{mesh, 0}; }
+    iterator end() const { return iterator{mesh, count}; }
+    int size() const { return count; }
+  };
+
+  // PLY loading strategy: memory mapped in place parsing or iostream parsing
+  enum PlyLoader {
+    PLY_LOAD_MAPPED,
+    PLY_LOAD_STREAM,
+  };
+
+  // Half-edge of a face, going from origin to the origin of next.
+  // twin is the opposite half-edge in the neighbor face, -1 on boundary edges
+  struct HalfEdge {
+    int origin;
+    int face;
+    int next, prev;
+    int twin;
+  };
+
+  // Hash over the exact coordinates of a vertex (-0.0 and 0.0 hash equal)
+  struct VertexHash {
+    std::size_t operator()(const Vertex3D& v) const;
   };
 
   class Mesh {
   private:
-    std::vector<MeshVertex> vertices;
-    std::vector<MeshFace> faces;
+    // Vertex positions, structure of arrays
+    std::vector<MeshReal> xs, ys, zs;
+    // Faces. Face f uses the vertex ids
+    // face_indices[face_offsets[f]] .. face_indices[face_offsets[f + 1] - 1]
+    std::vector<int> face_offsets = {0};
+    std::vector<int> face_indices;
+    std::vector<std::uint8_t> face_r, face_g, face_b;
+
+    void push_vertex(const Vertex3D& vertex);
+    void push_face_color(int r, int g, int b);
+
+    // Vertex index used to weld vertices on insertion.
+    // Exact mode (weld_epsilon == 0) maps coordinates to vertex id.
+    // Epsilon mode buckets vertices in a grid of cells of size weld_epsilon.
+    double weld_epsilon = 0;
+    bool vertex_index_valid = false;
+    std::unordered_map<Vertex3D, int, VertexHash> vertex_index;
+    std::unordered_multimap<std::size_t, int> vertex_grid;
+
+    std::size_t get_cell_key(long long cx, long long cy, long long cz);
+    void build_vertex_index();
+    void invalidate_vertex_index();
+    void index_vertex(int vertex_id);
+    void unindex_vertex(int vertex_id);
+    int find_vertex(const Vertex3D& vertex);
+
+    // Connectivity. Built on first query in O(F), then kept up to date by insert_face.
+    // edge_half_edge maps an undirected edge to the first half-edge inserted on it,
+    // edge_next chains the following ones in insertion order (-1 ends the chain),
+    // so non-manifold edges keep all their faces. twin pairs the first two
+    bool adjacency_valid = false;
+    std::vector<HalfEdge> half_edges;
+    std::vector<int> edge_next;
+    std::vector<int> face_half_edge;
+    std::vector<int> vertex_half_edge;
+    std::unordered_map<std::uint64_t, int> edge_half_edge;
+
+    static std::uint64_t get_edge_key(int v1, int v2);
+    void build_adjacency();
+    void add_face_half_edges(int face_id);
+    std::vector<int> get_vertex_half_edges(int vertex_id);
 
-    std::string get_header();
-    std::string get_vertex_string();
-    std::string get_face_string();
+    std::string get_header(PlyFormat format);
+    void write_vertices(PlyWriter& writer, PlyFormat format);
+    void write_faces(PlyWriter& writer, PlyFormat format);
+    void load_ply_mapped(const std::string& filename);
+    void load_ply_stream(const std::string& filename);
 
     Vertex3D to_vertex(const MeshVertex& vertex);
-    Face3D to_face(const MeshFace& face);
+    Face3D to_face(int face_index);
   public:
-    Mesh(const std::vector<Face3D>& faces);
-    Mesh(const std::string& filename);
-    void save_ply(const char* filename);
+    Mesh(const std::vector<Face3D>& faces, double weld_epsilon = 0);
+    Mesh(const std::vector<Vertex3D>& vertices, std::vector<int> face_offsets, std::vector<int> face_indices);
+    Mesh(const std::string& filename, PlyLoader loader = PLY_LOAD_MAPPED);
+    void save_ply(const char* filename, PlyFormat format = PLY_ASCII);
 
     int insert_face(const Face3D& face);
     int insert_vertex(const Vertex3D& vertex);
+    void set_weld_epsilon(double epsilon);
+    double get_weld_epsilon();
     std::vector<Vertex3D> get_vertices();
     Vertex3D get_vertex(int index);
     std::vector<Face3D> get_faces();
     Face3D get_face(int index);
+    FaceView get_face_view(int index);
+    FaceRange get_face_views();
+    int get_vertex_count();
+    int get_face_count();
+    IndexSpan get_face_vertex_ids(int index);
+    // Flat buffers
+    const std::vector<int>& get_face_offsets();
+    const std::vector<int>& get_face_indices();
+    const std::vector<MeshReal>& get_xs();
+    const std::vector<MeshReal>& get_ys();
+    const std::vector<MeshReal>& get_zs();
+    // Connectivity queries
+    const std::vector<HalfEdge>& get_half_edges();
+    int get_half_edge(int v1, int v2);
+    std::vector<int> get_edge_faces(int v1, int v2);
+    std::vector<int> get_vertex_neighbors(int vertex_id);
+    std::vector<int> get_vertex_faces(int vertex_id);
+    bool is_boundary_edge(int v1, int v2);
+    std::vector<std::pair<int, int>> get_boundary_edges();
     // Utility
     std::vector<Face3D> get_faces_with_edge(const Edge3D& edge);
-    Vertex3D get_face_midpoint(const MeshFace& face);
     Vertex3D get_face_midpoint(int face_index);
+    std::vector<Vertex3D> get_face_normals();
     void move_point(const Vertex3D& point, const Vertex3D& target);
     void displace(const Vertex3D& v);
   };
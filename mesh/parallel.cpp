@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cassert>
+#include "parallel.h"
+
+namespace mesh {
+  // Worker running on this thread, set by TaskPool::worker_loop. The id only
+  // means something together with the pool, read it through current_worker
+  static thread_local int current_worker_id = -1;
+  static thread_local TaskPool* current_pool = nullptr;
+
+  TaskPool::TaskPool(int thread_count) : pending(0), queued(0), next_worker(0), stopping(false) {
+    if (thread_count <= 0) {
+      thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (int i = 0; i < thread_count; i++) {
+      workers.push_back(std::make_unique<Worker>());
+    }
+    for (int i = 0; i < thread_count; i++) {
+      threads.emplace_back([this, i]() { worker_loop(i); });
+    }
+  }
+
+  TaskPool::~TaskPool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  int TaskPool::get_thread_count() {
+    return threads.size();
+  }
+
+  int TaskPool::current_worker() const {
+    return current_pool == this ? current_worker_id : -1;
+  }
+
+  void TaskPool::submit(Task task) {
+    pending++;
+    // Nested tasks stay on the deque of the worker that spawned them
+    int worker_id = current_worker();
+    int target = worker_id >= 0 ? worker_id : next_worker++ % workers.size();
+    {
+      std::lock_guard<std::mutex> lock(workers[target]->mutex);
+      workers[target]->tasks.push_back(std::move(task));
+    }
+    queued++;
+    // Taking the lock orders the push before a sleeping worker rechecks queued
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    wake.notify_one();
+  }
+
+  // Own deque, newest first
+  bool TaskPool::pop_task(int worker_id, Task& task) {
+    Worker& worker = *workers[worker_id];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+      return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    queued--;
+    return true;
+  }
+
+  // Other deques, oldest first
+  bool TaskPool::steal_task(int worker_id, Task& task) {
+    int count = workers.size();
+    int start = worker_id < 0 ? 0 : worker_id + 1;
+    for (int k = 0; k < count; k++) {
+      int victim = (start + k) % count;
+      if (victim == worker_id) {
+        continue;
+      }
+      Worker& worker = *workers[victim];
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      if (!worker.tasks.empty()) {
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        queued--;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool TaskPool::find_task(int worker_id, Task& task) {
+    if (worker_id >= 0 && pop_task(worker_id, task)) {
+      return true;
+    }
+    return steal_task(worker_id, task);
+  }
+
+  void TaskPool::run_task(Task& task) {
+    task();
+    task = nullptr;
+    if (--pending == 0) {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      idle.notify_all();
+    }
+  }
+
+  void TaskPool::worker_loop(int worker_id) {
+    current_worker_id = worker_id;
+    current_pool = this;
+    Task task;
+    while (true) {
+      if (find_task(worker_id, task)) {
+        run_task(task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex);
+      if (queued > 0) {
+        continue;
+      }
+      if (stopping) {
+        return;
+      }
+      wake.wait(lock);
+    }
+  }
+
+  void TaskPool::wait() {
+    // The running task counts as pending, so waiting from inside one never returns
+    assert(current_pool != this);
+    int worker_id = current_worker();
+    Task task;
+    while (pending > 0) {
+      if (find_task(worker_id, task)) {
+        run_task(task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex);
+      if (pending == 0) {
+        break;
+      }
+      // Only woken when everything finishes. Tasks submitted meanwhile are
+      // picked up by the workers, which are notified through wake
+      idle.wait(lock);
+    }
+  }
+}
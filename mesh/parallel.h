@@ -0,0 +1,59 @@
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#ifndef MESH_PARALLEL_H
+#define MESH_PARALLEL_H
+
+namespace mesh {
+  using Task = std::function<void()>;
+
+  // Thread pool with one task deque per worker. Workers pop their own deque
+  // from the back and steal from the front of the others when it is empty.
+  // Tasks may submit more tasks, which go to the deque of the submitting worker
+  class TaskPool {
+  private:
+    struct Worker {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    // Submitted and not finished / submitted and not yet taken by a thread
+    std::atomic<int> pending;
+    std::atomic<int> queued;
+    std::atomic<unsigned> next_worker;
+    bool stopping;
+
+    bool pop_task(int worker_id, Task& task);
+    bool steal_task(int worker_id, Task& task);
+    bool find_task(int worker_id, Task& task);
+    void run_task(Task& task);
+    void worker_loop(int worker_id);
+  public:
+    // thread_count <= 0 uses one thread per hardware thread
+    TaskPool(int thread_count = 0);
+    ~TaskPool();
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+    void submit(Task task);
+    // Blocks until every submitted task (including nested ones) has finished.
+    // The calling thread runs tasks while it waits. Must not be called from a
+    // task of this pool, it would wait on its own task forever
+    void wait();
+    int get_thread_count();
+    // Index of this pool's worker running the calling thread, -1 on any other
+    // thread (including workers of other pools)
+    int current_worker() const;
+  };
+}
+
+#endif
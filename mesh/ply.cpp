@@ -0,0 +1,401 @@
+#include "ply.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <charconv>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MESH_PLY_MMAP
+#endif
+
+namespace mesh {
+  PlyType get_ply_type(const std::string& name) {
+    if (name == "char" || name == "int8") return PLY_CHAR;
+    if (name == "uchar" || name == "uint8") return PLY_UCHAR;
+    if (name == "short" || name == "int16") return PLY_SHORT;
+    if (name == "ushort" || name == "uint16") return PLY_USHORT;
+    if (name == "int" || name == "int32") return PLY_INT;
+    if (name == "uint" || name == "uint32") return PLY_UINT;
+    if (name == "float" || name == "float32") return PLY_FLOAT;
+    if (name == "double" || name == "float64") return PLY_DOUBLE;
+    return PLY_INVALID;
+  }
+
+  size_t get_ply_type_size(PlyType type) {
+    switch (type) {
+      case PLY_CHAR: return 1;
+      case PLY_UCHAR: return 1;
+      case PLY_SHORT: return 2;
+      case PLY_USHORT: return 2;
+      case PLY_INT: return 4;
+      case PLY_UINT: return 4;
+      case PLY_FLOAT: return 4;
+      case PLY_DOUBLE: return 8;
+      default: return 0;
+    }
+  }
+
+  // === Mapped file ===
+  MappedFile::MappedFile(const std::string& filename) :
+    data(nullptr), size(0), mapped(false) {
+  #ifdef MESH_PLY_MMAP
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd != -1) {
+      struct stat info;
+      if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+          madvise(address, info.st_size, MADV_SEQUENTIAL);
+          data = static_cast<const char*>(address);
+          size = info.st_size;
+          mapped = true;
+        }
+      }
+      close(fd);
+    }
+    if (mapped) {
+      return;
+    }
+  #endif
+    // Fallback: read the whole file
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+      return;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+  }
+
+  MappedFile::~MappedFile() {
+  #ifdef MESH_PLY_MMAP
+    if (mapped) {
+      munmap(const_cast<char*>(data), size);
+    }
+  #endif
+  }
+
+  bool MappedFile::is_open() {
+    return data != nullptr;
+  }
+
+  const char* MappedFile::begin() {
+    return data;
+  }
+
+  const char* MappedFile::end() {
+    return data + size;
+  }
+
+  // === Header ===
+  static bool read_header_line(const char*& cursor, const char* end, std::string& line) {
+    if (cursor >= end) {
+      return false;
+    }
+    const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+    const char* line_end = newline ? newline : end;
+    line.assign(cursor, line_end);
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    cursor = newline ? newline + 1 : end;
+    return true;
+  }
+
+  bool parse_ply_header(const char*& cursor, const char* end, PlyHeader& header) {
+    std::string line;
+    read_header_line(cursor, end, line);
+    if (line != "ply") {
+      std::cerr << "Invalid PLY file" << std::endl;
+      return false;
+    }
+    read_header_line(cursor, end, line);
+    if (line == "format ascii 1.0") {
+      header.format = PLY_ASCII;
+    }
+    else if (line == "format binary_little_endian 1.0") {
+      header.format = PLY_BINARY_LITTLE_ENDIAN;
+    }
+    else {
+      std::cerr << "Invalid PLY fileformat" << std::endl;
+      return false;
+    }
+    header.elements.clear();
+    while (read_header_line(cursor, end, line)) {
+      if (line.rfind("end_header", 0) == 0) {
+        return true;
+      }
+      // Split line by spaces
+      std::istringstream iss(line);
+      std::string t1, t2, t3, t4, t5;
+      iss >> t1 >> t2 >> t3 >> t4 >> t5;
+      if (t1 == "element") {
+        PlyElement element;
+        element.name = t2;
+        element.count = std::stoi(t3);
+        header.elements.push_back(element);
+      }
+      else if (t1 == "property" && !header.elements.empty()) {
+        PlyProperty property;
+        if (t2 == "list") {
+          // property list <count type> <item type> <name>
+          property.is_list = true;
+          property.count_type = get_ply_type(t3);
+          property.type = get_ply_type(t4);
+          property.name = t5;
+        }
+        else {
+          property.is_list = false;
+          property.count_type = PLY_INVALID;
+          property.type = get_ply_type(t2);
+          property.name = t3;
+        }
+        if (property.type == PLY_INVALID || (property.is_list && property.count_type == PLY_INVALID)) {
+          std::cerr << "Invalid PLY property: " << line << std::endl;
+          return false;
+        }
+        header.elements.back().properties.push_back(property);
+      }
+    }
+    std::cerr << "Missing PLY end_header" << std::endl;
+    return false;
+  }
+
+  // === ASCII values ===
+  static void skip_whitespace(const char*& cursor, const char* end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\n' || *cursor == '\r' || *cursor == '\t')) {
+      cursor++;
+    }
+  }
+
+  bool parse_ascii_int(const char*& cursor, const char* end, long long& value) {
+    skip_whitespace(cursor, end);
+    const char* p = cursor;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+      negative = *p == '-';
+      p++;
+    }
+    const char* digits = p;
+    long long result = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+      result = result * 10 + (*p - '0');
+      p++;
+    }
+    if (p == digits) {
+      return false;
+    }
+    // Integers written as decimals (e.g. "3.0"): let the double parser handle them
+    if (p < end && (*p == '.' || *p == 'e' || *p == 'E')) {
+      double real;
+      if (!parse_ascii_double(cursor, end, real)) {
+        return false;
+      }
+      value = (long long) real;
+      return true;
+    }
+    value = negative ? -result : result;
+    cursor = p;
+    return true;
+  }
+
+  bool parse_ascii_double(const char*& cursor, const char* end, double& value) {
+    // Exact powers of ten representable as doubles
+    static const double powers[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    skip_whitespace(cursor, end);
+    const char* p = cursor;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+      negative = *p == '-';
+      p++;
+    }
+    std::uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    bool truncated = false;
+    bool any_digit = false;
+    while (p < end && *p >= '0' && *p <= '9') {
+      any_digit = true;
+      if (digits < 19) {
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa != 0) {
+          digits++;
+        }
+      }
+      else {
+        truncated = true;
+        exponent++;
+      }
+      p++;
+    }
+    if (p < end && *p == '.') {
+      p++;
+      while (p < end && *p >= '0' && *p <= '9') {
+        any_digit = true;
+        if (digits < 19) {
+          mantissa = mantissa * 10 + (*p - '0');
+          if (mantissa != 0) {
+            digits++;
+          }
+          exponent--;
+        }
+        else {
+          truncated = true;
+        }
+        p++;
+      }
+    }
+    if (any_digit && p < end && (*p == 'e' || *p == 'E')) {
+      const char* q = p + 1;
+      bool negative_exponent = false;
+      if (q < end && (*q == '-' || *q == '+')) {
+        negative_exponent = *q == '-';
+        q++;
+      }
+      int explicit_exponent = 0;
+      const char* exponent_digits = q;
+      while (q < end && *q >= '0' && *q <= '9') {
+        if (explicit_exponent < 10000) {
+          explicit_exponent = explicit_exponent * 10 + (*q - '0');
+        }
+        q++;
+      }
+      if (q != exponent_digits) {
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+        p = q;
+      }
+    }
+    // Fast path (Clinger): exact mantissa and exact power of ten give a correctly rounded result
+    if (any_digit && !truncated && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+      double result = (double) mantissa;
+      result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+      value = negative ? -result : result;
+      cursor = p;
+      return true;
+    }
+    // Slow path: long mantissas, large exponents, inf and nan
+    const char* start = cursor;
+    if (start < end && *start == '+') {
+      start++;
+    }
+    auto result = std::from_chars(start, end, value);
+    if (result.ec != std::errc()) {
+      return false;
+    }
+    cursor = result.ptr;
+    return true;
+  }
+
+  // === Binary values ===
+  template <typename T>
+  static double read_binary(const char*& cursor) {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return (double) from_little_endian(value);
+  }
+
+  bool parse_binary_value(const char*& cursor, const char* end, PlyType type, double& value) {
+    if ((size_t)(end - cursor) < get_ply_type_size(type)) {
+      return false;
+    }
+    switch (type) {
+      case PLY_CHAR: value = read_binary<std::int8_t>(cursor); return true;
+      case PLY_UCHAR: value = read_binary<std::uint8_t>(cursor); return true;
+      case PLY_SHORT: value = read_binary<std::int16_t>(cursor); return true;
+      case PLY_USHORT: value = read_binary<std::uint16_t>(cursor); return true;
+      case PLY_INT: value = read_binary<std::int32_t>(cursor); return true;
+      case PLY_UINT: value = read_binary<std::uint32_t>(cursor); return true;
+      case PLY_FLOAT: value = read_binary<float>(cursor); return true;
+      case PLY_DOUBLE: value = read_binary<double>(cursor); return true;
+      default: return false;
+    }
+  }
+
+  bool parse_ply_value(const char*& cursor, const char* end, PlyType type, PlyFormat format, double& value) {
+    if (format != PLY_ASCII) {
+      return parse_binary_value(cursor, end, type, value);
+    }
+    if (type == PLY_FLOAT || type == PLY_DOUBLE) {
+      return parse_ascii_double(cursor, end, value);
+    }
+    long long integer;
+    if (!parse_ascii_int(cursor, end, integer)) {
+      return false;
+    }
+    value = (double) integer;
+    return true;
+  }
+
+  // === Writer ===
+  PlyWriter::PlyWriter(const char* filename, size_t buffer_size) :
+    buffer(std::max<size_t>(buffer_size, 512)), used(0) {
+    file.open(filename, std::ios::binary);
+  }
+
+  PlyWriter::~PlyWriter() {
+    flush();
+    file.close();
+  }
+
+  bool PlyWriter::is_open() {
+    return file.is_open();
+  }
+
+  void PlyWriter::flush() {
+    if (used > 0) {
+      file.write(buffer.data(), used);
+      used = 0;
+    }
+  }
+
+  // Make room for at most bytes more characters
+  void PlyWriter::reserve(size_t bytes) {
+    if (used + bytes > buffer.size()) {
+      flush();
+    }
+  }
+
+  void PlyWriter::write(const char* data, size_t size) {
+    if (size > buffer.size()) {
+      flush();
+      file.write(data, size);
+      return;
+    }
+    reserve(size);
+    std::memcpy(buffer.data() + used, data, size);
+    used += size;
+  }
+
+  void PlyWriter::write(const std::string& text) {
+    write(text.data(), text.size());
+  }
+
+  void PlyWriter::write_char(char c) {
+    reserve(1);
+    buffer[used++] = c;
+  }
+
+  void PlyWriter::write_int(long long value) {
+    reserve(24);
+    char* begin = buffer.data() + used;
+    auto result = std::to_chars(begin, buffer.data() + buffer.size(), value);
+    used += result.ptr - begin;
+  }
+
+  void PlyWriter::write_double(double value) {
+    // Fixed notation of the largest double takes 309 digits plus sign, point and decimals
+    reserve(320);
+    char* begin = buffer.data() + used;
+    auto result = std::to_chars(begin, buffer.data() + buffer.size(), value, std::chars_format::fixed, 6);
+    used += result.ptr - begin;
+  }
+}
\ No newline at end of file
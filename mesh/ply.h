@@ -0,0 +1,118 @@
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+#ifndef MESH_PLY_H
+#define MESH_PLY_H
+
+namespace mesh {
+  // PLY encodings supported by the reader and writer
+  enum PlyFormat {
+    PLY_ASCII,
+    PLY_BINARY_LITTLE_ENDIAN,
+  };
+
+  // PLY property types (int8..float64 aliases map to the same values)
+  enum PlyType {
+    PLY_CHAR,
+    PLY_UCHAR,
+    PLY_SHORT,
+    PLY_USHORT,
+    PLY_INT,
+    PLY_UINT,
+    PLY_FLOAT,
+    PLY_DOUBLE,
+    PLY_INVALID,
+  };
+
+  struct PlyProperty {
+    std::string name;
+    PlyType type;
+    bool is_list;
+    PlyType count_type;
+  };
+
+  struct PlyElement {
+    std::string name;
+    int count;
+    std::vector<PlyProperty> properties;
+  };
+
+  struct PlyHeader {
+    PlyFormat format;
+    std::vector<PlyElement> elements;
+  };
+
+  PlyType get_ply_type(const std::string& name);
+  size_t get_ply_type_size(PlyType type);
+
+  // PLY binary data is little endian
+  template <typename T>
+  T from_little_endian(T value) {
+  #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    char* bytes = reinterpret_cast<char*>(&value);
+    std::reverse(bytes, bytes + sizeof(T));
+  #endif
+    return value;
+  }
+
+  // Read-only view over a whole file. Memory mapped when the platform allows it,
+  // read into a buffer otherwise
+  class MappedFile {
+  private:
+    const char* data;
+    size_t size;
+    bool mapped;
+    std::vector<char> buffer;
+  public:
+    MappedFile(const std::string& filename);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    bool is_open();
+    const char* begin();
+    const char* end();
+  };
+
+  // Buffered output. Values are formatted straight into a fixed size buffer
+  // that is written to the file every time it fills up
+  class PlyWriter {
+  private:
+    std::ofstream file;
+    std::vector<char> buffer;
+    size_t used;
+    void reserve(size_t bytes);
+  public:
+    PlyWriter(const char* filename, size_t buffer_size = 1 << 16);
+    ~PlyWriter();
+    bool is_open();
+    void flush();
+    void write(const char* data, size_t size);
+    void write(const std::string& text);
+    void write_char(char c);
+    void write_int(long long value);
+    // Fixed notation with 6 decimals, same output as std::to_string
+    void write_double(double value);
+    template <typename T>
+    void write_binary(T value) {
+      reserve(sizeof(T));
+      value = from_little_endian(value);
+      std::memcpy(buffer.data() + used, &value, sizeof(T));
+      used += sizeof(T);
+    }
+  };
+
+  // In place parsing. All of them advance cursor past the parsed data
+  // and return false on malformed or truncated input
+  bool parse_ply_header(const char*& cursor, const char* end, PlyHeader& header);
+  bool parse_ascii_int(const char*& cursor, const char* end, long long& value);
+  bool parse_ascii_double(const char*& cursor, const char* end, double& value);
+  bool parse_binary_value(const char*& cursor, const char* end, PlyType type, double& value);
+  bool parse_ply_value(const char*& cursor, const char* end, PlyType type, PlyFormat format, double& value);
+}
+
+#endif
@@ -0,0 +1,192 @@
+#include "scene.h"
+
+namespace mesh {
+  // Instances per top level leaf
+  const int TLAS_LEAF_SIZE = 2;
+  const int TLAS_STACK_SIZE = 64;
+
+  int Scene::add_mesh(Mesh& mesh) {
+    meshes.push_back(&mesh);
+    baked.push_back(std::make_unique<BakedMesh>(mesh));
+    blas.push_back(std::make_unique<BVH>(*baked.back()));
+    return meshes.size() - 1;
+  }
+
+  int Scene::add_instance(int mesh_id, const Transform3D& transform) {
+    instances.push_back(SceneInstance{mesh_id, transform, transform.inverse(), transform.determinant() < 0});
+    return instances.size() - 1;
+  }
+
+  // World box around the transformed corners of the bottom level bounds
+  AABB Scene::get_instance_bounds(int instance_id) {
+    const SceneInstance& instance = instances[instance_id];
+    const AABB& local = blas[instance.mesh]->get_bounds();
+    AABB bounds;
+    for (int corner = 0; corner < 8; corner++) {
+      Vertex3D p(
+        corner & 1 ? local.max.x : local.min.x,
+        corner & 2 ? local.max.y : local.min.y,
+        corner & 4 ? local.max.z : local.min.z
+      );
+      bounds.grow(instance.transform.apply_point(p));
+    }
+    return bounds;
+  }
+
+  void Scene::build() {
+    std::vector<int> instance_ids;
+    for (int i = 0; i < (int) instances.size(); i++) {
+      instance_ids.push_back(i);
+    }
+    build_tlas(instance_ids);
+  }
+
+  void Scene::build(const ViewFrustum& frustum) {
+    std::vector<int> instance_ids;
+    for (int i = 0; i < (int) instances.size(); i++) {
+      const SceneInstance& instance = instances[i];
+      if (sphere_in_frustum(instance.transform.apply(baked[instance.mesh]->get_bounds()), frustum)) {
+        instance_ids.push_back(i);
+      }
+    }
+    build_tlas(instance_ids);
+  }
+
+  void Scene::set_cull_back_faces(bool cull) {
+    cull_back_faces = cull;
+  }
+
+  void Scene::build_tlas(const std::vector<int>& instance_ids) {
+    instance_bounds.clear();
+    for (int i = 0; i < (int) instances.size(); i++) {
+      instance_bounds.push_back(get_instance_bounds(i));
+    }
+    tlas_instances = instance_ids;
+    tlas_nodes.clear();
+    if (tlas_instances.empty()) {
+      return;
+    }
+    tlas_nodes.push_back(BVHNode{AABB(), 0, (int) tlas_instances.size()});
+    subdivide_tlas(0);
+  }
+
+  // Median split on the longest axis of the instance centers
+  void Scene::subdivide_tlas(int node_id) {
+    BVHNode& node = tlas_nodes[node_id];
+    AABB centers;
+    for (int i = node.left_first; i < node.left_first + node.count; i++) {
+      const AABB& box = instance_bounds[tlas_instances[i]];
+      node.bounds.grow(box);
+      centers.grow((box.min + box.max) / 2.0);
+    }
+    if (node.count <= TLAS_LEAF_SIZE) {
+      return;
+    }
+    Vertex3D extent = centers.max - centers.min;
+    int axis = extent.x > extent.y && extent.x > extent.z ? 0 : (extent.y > extent.z ? 1 : 2);
+    int first = node.left_first;
+    int count = node.count;
+    int middle = first + count / 2;
+    std::nth_element(
+      tlas_instances.begin() + first,
+      tlas_instances.begin() + middle,
+      tlas_instances.begin() + first + count,
+      [&](int a, int b) {
+        const AABB& box_a = instance_bounds[a];
+        const AABB& box_b = instance_bounds[b];
+        return get_axis(box_a.min + box_a.max, axis) < get_axis(box_b.min + box_b.max, axis);
+      }
+    );
+    // Children are stored next to each other
+    int left_id = tlas_nodes.size();
+    tlas_nodes[node_id].left_first = left_id;
+    tlas_nodes[node_id].count = 0;
+    tlas_nodes.push_back(BVHNode{AABB(), first, middle - first});
+    tlas_nodes.push_back(BVHNode{AABB(), middle, first + count - middle});
+    subdivide_tlas(left_id);
+    subdivide_tlas(left_id + 1);
+  }
+
+  std::optional<SceneHit> Scene::intersect(const Line3D& ray, double t_min, double t_max) {
+    if (tlas_nodes.empty()) {
+      return std::nullopt;
+    }
+    Vertex3D inv_direction(1.0 / ray.direction.x, 1.0 / ray.direction.y, 1.0 / ray.direction.z);
+    const double miss = std::numeric_limits<double>::infinity();
+    double closest_t = t_max;
+    int closest_instance = -1;
+    BVHHit closest_hit;
+    int stack[TLAS_STACK_SIZE];
+    int stack_size = 0;
+    if (intersect_aabb(tlas_nodes[0].bounds, ray.point, inv_direction, t_min, closest_t) == miss) {
+      return std::nullopt;
+    }
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+      const BVHNode& node = tlas_nodes[stack[--stack_size]];
+      if (node.is_leaf()) {
+        for (int i = node.left_first; i < node.left_first + node.count; i++) {
+          int instance_id = tlas_instances[i];
+          const SceneInstance& instance = instances[instance_id];
+          // Affine maps keep t, as the direction is not normalized
+          Line3D local_ray(instance.inverse.apply_point(ray.point), instance.inverse.apply_vector(ray.direction));
+          auto hit = blas[instance.mesh]->intersect(local_ray, t_min, closest_t, cull_back_faces && !instance.mirrored);
+          if (hit.has_value()) {
+            closest_t = hit.value().t;
+            closest_instance = instance_id;
+            closest_hit = hit.value();
+          }
+        }
+        continue;
+      }
+      // Push the far child first so the near one is visited next
+      int near_id = node.left_first;
+      int far_id = node.left_first + 1;
+      double near_t = intersect_aabb(tlas_nodes[near_id].bounds, ray.point, inv_direction, t_min, closest_t);
+      double far_t = intersect_aabb(tlas_nodes[far_id].bounds, ray.point, inv_direction, t_min, closest_t);
+      if (far_t < near_t) {
+        std::swap(near_id, far_id);
+        std::swap(near_t, far_t);
+      }
+      if (far_t != miss) {
+        stack[stack_size++] = far_id;
+      }
+      if (near_t != miss) {
+        stack[stack_size++] = near_id;
+      }
+    }
+    if (closest_instance < 0) {
+      return std::nullopt;
+    }
+    const SceneInstance& instance = instances[closest_instance];
+    Vertex3D normal = instance.transform.apply_normal(baked[instance.mesh]->get_triangle(closest_hit.triangle).get_normal());
+    return SceneHit{
+      closest_t,
+      closest_instance,
+      closest_hit.triangle,
+      closest_hit.face,
+      ray.point + ray.direction * closest_t,
+      normal
+    };
+  }
+
+  int Scene::get_mesh_count() {
+    return meshes.size();
+  }
+
+  int Scene::get_instance_count() {
+    return instances.size();
+  }
+
+  Mesh& Scene::get_mesh(int mesh_id) {
+    return *meshes[mesh_id];
+  }
+
+  const BakedMesh& Scene::get_baked(int mesh_id) {
+    return *baked[mesh_id];
+  }
+
+  const SceneInstance& Scene::get_instance(int instance_id) {
+    return instances[instance_id];
+  }
+}
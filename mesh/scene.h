@@ -0,0 +1,81 @@
+#include <vector>
+#include <memory>
+#include <optional>
+#include <limits>
+#include "mesh.h"
+#include "baked.h"
+#include "bvh.h"
+#include "cull.h"
+#include "transform.h"
+
+#ifndef MESH_SCENE_H
+#define MESH_SCENE_H
+
+namespace mesh {
+  // Placement of a mesh in the scene
+  struct SceneInstance {
+    int mesh;
+    Transform3D transform;
+    Transform3D inverse;
+    // Negative determinant, the transform flips the winding of the triangles
+    bool mirrored;
+  };
+
+  struct SceneHit {
+    double t;
+    int instance;
+    // Baked triangle and face of the source mesh
+    int triangle;
+    int face;
+    // World space
+    Vertex3D point;
+    Vertex3D normal;
+  };
+
+  // Meshes and their instances. Each mesh is baked once and gets one bottom
+  // level BVH in its own space, shared by all its instances. A top level BVH
+  // over the instance bounds finds the instances a ray may hit, and the ray is
+  // moved into their space to query the bottom level.
+  // Meshes are held by reference and must outlive the scene; add them again after
+  // changing them
+  class Scene {
+  private:
+    std::vector<Mesh*> meshes;
+    std::vector<std::unique_ptr<BakedMesh>> baked;
+    std::vector<std::unique_ptr<BVH>> blas;
+    std::vector<SceneInstance> instances;
+    // Top level. Leaves hold count instances of tlas_instances starting at left_first
+    std::vector<int> tlas_instances;
+    std::vector<AABB> instance_bounds;
+    std::vector<BVHNode> tlas_nodes;
+    bool cull_back_faces = false;
+
+    AABB get_instance_bounds(int instance_id);
+    void build_tlas(const std::vector<int>& instance_ids);
+    void subdivide_tlas(int node_id);
+  public:
+    int add_mesh(Mesh& mesh);
+    int add_instance(int mesh_id, const Transform3D& transform = Transform3D());
+    // Builds the top level over every instance, or only over the instances
+    // whose bounding sphere reaches the frustum. Call before intersect
+    void build();
+    void build(const ViewFrustum& frustum);
+    // Skip triangles facing away from each ray. Done per ray in intersect, so
+    // the bottom levels stay shared and independent of the view. Relies on
+    // consistent outward winding; mirrored instances are still tested two sided
+    void set_cull_back_faces(bool cull);
+    // Closest hit with t_min <= t <= t_max along ray.point + ray.direction * t
+    std::optional<SceneHit> intersect(
+      const Line3D& ray,
+      double t_min = 0,
+      double t_max = std::numeric_limits<double>::max()
+    );
+    int get_mesh_count();
+    int get_instance_count();
+    Mesh& get_mesh(int mesh_id);
+    const BakedMesh& get_baked(int mesh_id);
+    const SceneInstance& get_instance(int instance_id);
+  };
+}
+
+#endif
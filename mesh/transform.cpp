@@ -0,0 +1,148 @@
+#include "transform.h"
+
+namespace mesh {
+  Transform3D::Transform3D() : t(0, 0, 0) {
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        m[i][j] = i == j ? 1 : 0;
+      }
+    }
+  }
+
+  Transform3D Transform3D::translation(const Vertex3D& v) {
+    Transform3D transform;
+    transform.t = v;
+    return transform;
+  }
+
+  Transform3D Transform3D::scaling(double sx, double sy, double sz) {
+    Transform3D transform;
+    transform.m[0][0] = sx;
+    transform.m[1][1] = sy;
+    transform.m[2][2] = sz;
+    return transform;
+  }
+
+  Transform3D Transform3D::rotation_x(double angle) {
+    Transform3D transform;
+    double c = std::cos(angle), s = std::sin(angle);
+    transform.m[1][1] = c; transform.m[1][2] = -s;
+    transform.m[2][1] = s; transform.m[2][2] = c;
+    return transform;
+  }
+
+  Transform3D Transform3D::rotation_y(double angle) {
+    Transform3D transform;
+    double c = std::cos(angle), s = std::sin(angle);
+    transform.m[0][0] = c; transform.m[0][2] = s;
+    transform.m[2][0] = -s; transform.m[2][2] = c;
+    return transform;
+  }
+
+  Transform3D Transform3D::rotation_z(double angle) {
+    Transform3D transform;
+    double c = std::cos(angle), s = std::sin(angle);
+    transform.m[0][0] = c; transform.m[0][1] = -s;
+    transform.m[1][0] = s; transform.m[1][1] = c;
+    return transform;
+  }
+
+  Vertex3D Transform3D::apply_vector(const Vertex3D& v) const {
+    return Vertex3D(
+      m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+      m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+      m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z
+    );
+  }
+
+  Vertex3D Transform3D::apply_point(const Vertex3D& p) const {
+    return apply_vector(p) + t;
+  }
+
+  // The cofactor matrix is det * inverse transpose, so no inverse is needed
+  Vertex3D Transform3D::apply_normal(const Vertex3D& n) const {
+    double c[3][3];
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+        int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+        c[i][j] = m[i1][j1] * m[i2][j2] - m[i1][j2] * m[i2][j1];
+      }
+    }
+    double det = m[0][0] * c[0][0] + m[0][1] * c[0][1] + m[0][2] * c[0][2];
+    Vertex3D result(
+      c[0][0] * n.x + c[0][1] * n.y + c[0][2] * n.z,
+      c[1][0] * n.x + c[1][1] * n.y + c[1][2] * n.z,
+      c[2][0] * n.x + c[2][1] * n.y + c[2][2] * n.z
+    );
+    result = result.normalized();
+    return det < 0 ? result * -1.0 : result;
+  }
+
+  TriangleRecord Transform3D::apply(const TriangleRecord& triangle) const {
+    TriangleRecord result = triangle;
+    Vertex3D v0 = apply_point(triangle.get_vertex(0));
+    Vertex3D e1 = apply_vector(triangle.get_edge1());
+    Vertex3D e2 = apply_vector(triangle.get_edge2());
+    Vertex3D normal = apply_normal(triangle.get_normal());
+    result.v0[0] = v0.x; result.v0[1] = v0.y; result.v0[2] = v0.z;
+    result.e1[0] = e1.x; result.e1[1] = e1.y; result.e1[2] = e1.z;
+    result.e2[0] = e2.x; result.e2[1] = e2.y; result.e2[2] = e2.z;
+    result.normal[0] = normal.x; result.normal[1] = normal.y; result.normal[2] = normal.z;
+    return result;
+  }
+
+  // The radius grows by sqrt(|M|_1 |M|_inf), an upper bound of the stretch of the transform
+  BoundingSphere Transform3D::apply(const BoundingSphere& sphere) const {
+    double max_column = 0, max_row = 0;
+    for (int i = 0; i < 3; i++) {
+      max_column = std::max(max_column, std::abs(m[0][i]) + std::abs(m[1][i]) + std::abs(m[2][i]));
+      max_row = std::max(max_row, std::abs(m[i][0]) + std::abs(m[i][1]) + std::abs(m[i][2]));
+    }
+    return BoundingSphere{apply_point(sphere.center), sphere.radius * std::sqrt(max_column * max_row)};
+  }
+
+  double Transform3D::determinant() const {
+    return
+      m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+      m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+      m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+  }
+
+  Transform3D Transform3D::inverse() const {
+    // Adjugate over determinant
+    double inv_det = 1.0 / determinant();
+    Transform3D result;
+    result.m[0][0] = (m[1][1] * m[2][2] - m[1][2] * m[2][1]) * inv_det;
+    result.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv_det;
+    result.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv_det;
+    result.m[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) * inv_det;
+    result.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv_det;
+    result.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv_det;
+    result.m[2][0] = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) * inv_det;
+    result.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv_det;
+    result.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv_det;
+    // -M^-1 t
+    Vertex3D inv_t = result.apply_vector(t);
+    result.t = Vertex3D(-inv_t.x, -inv_t.y, -inv_t.z);
+    return result;
+  }
+
+  bool Transform3D::is_identity() const {
+    return t == Vertex3D(0, 0, 0)
+      && m[0][0] == 1 && m[0][1] == 0 && m[0][2] == 0
+      && m[1][0] == 0 && m[1][1] == 1 && m[1][2] == 0
+      && m[2][0] == 0 && m[2][1] == 0 && m[2][2] == 1;
+  }
+
+  Transform3D operator*(const Transform3D& a, const Transform3D& b) {
+    Transform3D result;
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        result.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j];
+      }
+    }
+    result.t = a.apply_point(b.t);
+    return result;
+  }
+}
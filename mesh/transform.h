@@ -0,0 +1,36 @@
+#include "3d.h"
+#include "baked.h"
+
+#ifndef MESH_TRANSFORM_H
+#define MESH_TRANSFORM_H
+
+namespace mesh {
+  // Affine transform p' = m * p + t
+  struct Transform3D {
+    double m[3][3];
+    Vertex3D t;
+    Transform3D();
+    static Transform3D translation(const Vertex3D& v);
+    static Transform3D scaling(double sx, double sy, double sz);
+    // Angles in radians, counterclockwise looking down the axis
+    static Transform3D rotation_x(double angle);
+    static Transform3D rotation_y(double angle);
+    static Transform3D rotation_z(double angle);
+
+    Vertex3D apply_point(const Vertex3D& p) const;
+    Vertex3D apply_vector(const Vertex3D& v) const;
+    // Normals go through the inverse transpose. Result is normalized
+    Vertex3D apply_normal(const Vertex3D& n) const;
+    TriangleRecord apply(const TriangleRecord& triangle) const;
+    BoundingSphere apply(const BoundingSphere& sphere) const;
+    // Of m, negative when the transform mirrors
+    double determinant() const;
+    Transform3D inverse() const;
+    bool is_identity() const;
+  };
+
+  // a * b applies b first
+  Transform3D operator*(const Transform3D& a, const Transform3D& b);
+}
+
+#endif
@@ -0,0 +1,7 @@
+#include "CatmullClark.h"
+
+int main() {
+  Mesh sphere = catmullClark(5);
+  sphere.save_ply("outputs/ck.ply");
+  return 0;
+}
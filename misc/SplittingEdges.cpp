@@ -0,0 +1,7 @@
+#include "SplittingEdges.h"
+
+int main() {
+  Mesh sphere = sphereBySplittingEdges(3);
+  sphere.save_ply("outputs/sphere.ply");
+  return 0;
+}
@@ -0,0 +1,111 @@
+#include "framebuffer.h"
+#include <fstream>
+
+namespace render {
+  bool write_ppm(const std::string& filename, int width, int height, const std::uint8_t* rgb) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+      return false;
+    }
+    file << "P6\n" << width << " " << height << "\n255\n";
+    file.write((const char*) rgb, (std::streamsize) width * height * 3);
+    return file.good();
+  }
+
+  // === PNG ===
+  std::vector<std::uint32_t> make_crc_table() {
+    std::vector<std::uint32_t> table(256);
+    for (std::uint32_t n = 0; n < 256; n++) {
+      std::uint32_t c = n;
+      for (int k = 0; k < 8; k++) {
+        c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      table[n] = c;
+    }
+    return table;
+  }
+
+  std::uint32_t crc32(std::uint32_t crc, const std::uint8_t* data, size_t size) {
+    static const std::vector<std::uint32_t> table = make_crc_table();
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+      crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+  }
+
+  std::uint32_t adler32(const std::uint8_t* data, size_t size) {
+    std::uint32_t a = 1, b = 0;
+    // 5552 bytes is the most that can be summed before b overflows
+    for (size_t start = 0; start < size; start += 5552) {
+      size_t end = std::min(size, start + 5552);
+      for (size_t i = start; i < end; i++) {
+        a += data[i];
+        b += a;
+      }
+      a %= 65521;
+      b %= 65521;
+    }
+    return (b << 16) | a;
+  }
+
+  void push_u32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    out.push_back(value >> 24);
+    out.push_back(value >> 16);
+    out.push_back(value >> 8);
+    out.push_back(value);
+  }
+
+  // Length, type, data, CRC over type and data
+  void write_chunk(std::ofstream& file, const char* type, const std::vector<std::uint8_t>& data) {
+    std::vector<std::uint8_t> chunk;
+    chunk.reserve(data.size() + 12);
+    push_u32(chunk, data.size());
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    push_u32(chunk, crc32(0, chunk.data() + 4, data.size() + 4));
+    file.write((const char*) chunk.data(), chunk.size());
+  }
+
+  bool write_png(const std::string& filename, int width, int height, const std::uint8_t* rgb) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+      return false;
+    }
+    const std::uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write((const char*) signature, 8);
+    // 8 bit truecolor, no interlace
+    std::vector<std::uint8_t> header;
+    push_u32(header, width);
+    push_u32(header, height);
+    header.insert(header.end(), {8, 2, 0, 0, 0});
+    write_chunk(file, "IHDR", header);
+    // Scanlines with filter type 0
+    size_t row_size = (size_t) width * 3;
+    std::vector<std::uint8_t> raw;
+    raw.reserve((row_size + 1) * height);
+    for (int y = 0; y < height; y++) {
+      raw.push_back(0);
+      raw.insert(raw.end(), rgb + y * row_size, rgb + (y + 1) * row_size);
+    }
+    // zlib stream of stored deflate blocks (at most 65535 bytes each) and adler32
+    std::vector<std::uint8_t> zlib = {0x78, 0x01};
+    zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    size_t offset = 0;
+    do {
+      size_t block = std::min<size_t>(65535, raw.size() - offset);
+      bool last = offset + block == raw.size();
+      zlib.push_back(last ? 1 : 0);
+      zlib.push_back(block & 0xFF);
+      zlib.push_back(block >> 8);
+      zlib.push_back(~block & 0xFF);
+      zlib.push_back((~block >> 8) & 0xFF);
+      zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + block);
+      offset += block;
+    } while (offset < raw.size());
+    push_u32(zlib, adler32(raw.data(), raw.size()));
+    write_chunk(file, "IDAT", zlib);
+    write_chunk(file, "IEND", {});
+    return file.good();
+  }
+}
@@ -0,0 +1,54 @@
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+
+#ifndef RENDER_FRAMEBUFFER_H
+#define RENDER_FRAMEBUFFER_H
+
+namespace render {
+  // Image writers over packed 8 bit RGB rows, top row first.
+  // PPM is binary P6. PNG is truecolor with uncompressed (stored) deflate blocks
+  bool write_ppm(const std::string& filename, int width, int height, const std::uint8_t* rgb);
+  bool write_png(const std::string& filename, int width, int height, const std::uint8_t* rgb);
+
+  // Contiguous row-major RGB image. T is std::uint8_t for display images or
+  // float for accumulation. Float channels are stored in 0..255 and are
+  // clamped and truncated when saved
+  template <typename T>
+  class Framebuffer {
+  private:
+    int width, height;
+    std::vector<T> data;
+  public:
+    Framebuffer(int width, int height) : width(width), height(height), data(width * height * 3, T(0)) {}
+    int get_width() const { return width; }
+    int get_height() const { return height; }
+    T* get_pixel(int x, int y) { return data.data() + (y * width + x) * 3; }
+    const T* get_pixel(int x, int y) const { return data.data() + (y * width + x) * 3; }
+    void set_pixel(int x, int y, T r, T g, T b) {
+      T* pixel = get_pixel(x, y);
+      pixel[0] = r;
+      pixel[1] = g;
+      pixel[2] = b;
+    }
+    void clear() { std::fill(data.begin(), data.end(), T(0)); }
+    T* get_data() { return data.data(); }
+
+    std::vector<std::uint8_t> to_rgb8() const {
+      std::vector<std::uint8_t> rgb(data.size());
+      for (size_t i = 0; i < data.size(); i++) {
+        rgb[i] = (std::uint8_t) std::min(255.0, std::max(0.0, (double) data[i]));
+      }
+      return rgb;
+    }
+    bool save_ppm(const std::string& filename) const {
+      return write_ppm(filename, width, height, to_rgb8().data());
+    }
+    bool save_png(const std::string& filename) const {
+      return write_png(filename, width, height, to_rgb8().data());
+    }
+  };
+}
+
+#endif
@@ -4,8 +4,18 @@
 #include <optional>
 #include <limits>
 #include <string>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <chrono>
 #include "mesh.h"
+#include "framebuffer.h"
 #include "3d.h"
+#include "baked.h"
+#include "cull.h"
+#include "scene.h"
+#include "parallel.h"
 #include "SplittingEdges.h"
 
 using namespace mesh;
@@ -37,12 +47,10 @@ struct Camera{
   int width, height;
   int distance;
   double scale;
-  std::vector<std::vector<RGB>> pixels;
+  render::Framebuffer<std::uint8_t> film;
 
-  Camera(int width, int height, double distance, double scale=0.25) : width(width), height(height), distance(distance), scale(scale)
+  Camera(int width, int height, double distance, double scale=0.25) : width(width), height(height), distance(distance), scale(scale), film(width, height)
   {
-    // Initialize pixels
-    pixels = std::vector<std::vector<RGB>>(width, std::vector<RGB>(height, RGB{0, 0, 0}));
   }
 
 
@@ -55,7 +63,7 @@ struct Camera{
 
   Point2D toPixel(Point2D point){
     // Transform point to pixel
-    return Point2D{point.x * scale + width / 2.0, point.y * scale + height / 2.0};
+    return Point2D{point.x / scale + width / 2.0, point.y / scale + height / 2.0};
   }
 
   Point2D projectToFilm(Vertex3D vertex){
@@ -84,157 +92,244 @@ struct Camera{
     return Line3D(origin, dir);
   }
 
+  ViewFrustum getFrustum(){
+    // Film extents seen by the pixel grid
+    return ViewFrustum{(double) distance, width / 2.0 * scale, height / 2.0 * scale};
+  }
+
   void setPixel(int px, int py, RGB color){
-    pixels[px][py] = color;
+    // Channels are truncated like the previous text output
+    film.set_pixel(px, py, (int) color.r, (int) color.g, (int) color.b);
   }
 
   RGB getPixel(int px, int py){
-    return pixels[px][py];
-  }
-
-  void savePGM(std::string filename){
-    std::ofstream file;
-    file.open(filename);
-    file << "P3\n";
-    file << width << " " << height << "\n";
-    file << "255\n";
-    for (auto x = 0; x < width; x++){
-      for (auto y = 0; y < height; y++){
-        auto color = pixels[x][y];
-        file << (int) color.r << " " << (int) color.g << " " << (int) color.b << "\n";
-      }
-    }
-    file.close();
+    auto pixel = film.get_pixel(px, py);
+    return RGB{(double) pixel[0], (double) pixel[1], (double) pixel[2]};
+  }
+
+  void savePPM(std::string filename){
+    film.save_ppm(filename);
+  }
+
+  void savePNG(std::string filename){
+    film.save_png(filename);
   }
 };
 
 
-bool inside_convex_polygon(std::vector<Point2D> points, Point2D p){
-  // Check if point is inside convex polygon
-  for (int i = 0; i < points.size(); i++){
-    auto p1 = points[i];
-    auto p2 = points[(i + 1) % points.size()];
-    auto v1 = Point2D{p2.x - p1.x, p2.y - p1.y};
-    auto v2 = Point2D{p.x - p1.x, p.y - p1.y};
-    // Cross product
-    auto cross = v1.x * v2.y - v1.y * v2.x;
-    if (cross < 0){
-      return false;
-    }
+// Square block of pixels. Triangles are binned per tile and each tile is rasterized by one task
+const int TILE_SIZE = 16;
+// Triangles set up and binned by one task
+const int BIN_CHUNK_SIZE = 4096;
+
+// Triangle ready to rasterize, in pixel coordinates.
+// Edge i is e(x, y) = a[i] * x + b[i] * y + c[i], non negative inside.
+// Inverse depth is linear in screen space: 1/z = inv_z_x * x + inv_z_y * y + inv_z_0
+struct SetupTriangle{
+  double a[3], b[3], c[3];
+  double inv_z_x, inv_z_y, inv_z_0;
+  int min_x, min_y, max_x, max_y;
+  RGB color;
+};
+
+// Vertices are snapped to 1/SUBPIXELS of a pixel. Edge functions then only take
+// integer values (stored in doubles, exact below 2^24 subpixels), so the two
+// triangles sharing an edge get exactly opposite values and leave no gaps
+const double SUBPIXELS = 256;
+
+// Returns false when the triangle covers no pixel
+bool setupTriangle(Camera& camera, const TriangleRecord& triangle, SetupTriangle& setup){
+  Point2D p[3];
+  double inv_z[3];
+  for (auto i = 0; i < 3; i++){
+    auto vertex = triangle.get_vertex(i);
+    auto pixel = camera.projectToPixel(vertex);
+    p[i] = Point2D{std::round(pixel.x * SUBPIXELS), std::round(pixel.y * SUBPIXELS)};
+    inv_z[i] = 1.0 / vertex.z;
+  }
+  // Twice the signed area. Both windings are drawn
+  auto area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+  if (area == 0){
+    return false;
+  }
+  auto sign = area > 0 ? 1.0 : -1.0;
+  for (auto i = 0; i < 3; i++){
+    // Edge opposite to vertex i. a and b are scaled so x and y are in pixels
+    auto p1 = p[(i + 1) % 3];
+    auto p2 = p[(i + 2) % 3];
+    setup.a[i] = sign * (p1.y - p2.y) * SUBPIXELS;
+    setup.b[i] = sign * (p2.x - p1.x) * SUBPIXELS;
+    setup.c[i] = sign * (p1.x * p2.y - p1.y * p2.x);
   }
+  // Barycentric weight i is e_i / |area|
+  auto inv_area = 1.0 / std::abs(area);
+  setup.inv_z_x = (setup.a[0] * inv_z[0] + setup.a[1] * inv_z[1] + setup.a[2] * inv_z[2]) * inv_area;
+  setup.inv_z_y = (setup.b[0] * inv_z[0] + setup.b[1] * inv_z[1] + setup.b[2] * inv_z[2]) * inv_area;
+  setup.inv_z_0 = (setup.c[0] * inv_z[0] + setup.c[1] * inv_z[1] + setup.c[2] * inv_z[2]) * inv_area;
+  // Pixel bounding box, clipped to the film
+  setup.min_x = std::max(0, (int) std::ceil(std::min({p[0].x, p[1].x, p[2].x}) / SUBPIXELS));
+  setup.min_y = std::max(0, (int) std::ceil(std::min({p[0].y, p[1].y, p[2].y}) / SUBPIXELS));
+  setup.max_x = std::min(camera.width - 1, (int) std::floor(std::max({p[0].x, p[1].x, p[2].x}) / SUBPIXELS));
+  setup.max_y = std::min(camera.height - 1, (int) std::floor(std::max({p[0].y, p[1].y, p[2].y}) / SUBPIXELS));
+  if (setup.min_x > setup.max_x || setup.min_y > setup.max_y){
+    return false;
+  }
+  // Flat shading: cos of angle between normal and the ray to the center of the face
+  auto normal = triangle.get_normal();
+  auto ray = triangle.get_midpoint();
+  auto cos_angle = dot_product(normal, ray) / (normal.magnitude() * ray.magnitude());
+  setup.color = RGB{255, 255, 255} * std::abs(cos_angle);
   return true;
 }
 
+// Set up triangles of one chunk with their own bins, so chunks are binned in parallel
+struct BinChunk{
+  std::vector<SetupTriangle> triangles;
+  // Per tile ids into triangles
+  std::vector<std::vector<int>> bins;
+};
+
+void binChunk(Camera& camera, const std::vector<TriangleRecord>& records, int first, int last, int tiles_x, BinChunk& chunk){
+  for (auto i = first; i < last; i++){
+    auto& face = records[i];
+    // If midpoint is behind camera, skip
+    if (face.get_midpoint().z < camera.distance){
+      continue;
+    }
+    SetupTriangle setup;
+    if (!setupTriangle(camera, face, setup)){
+      continue;
+    }
+    // Bin into every tile its bounding box touches
+    int id = chunk.triangles.size();
+    chunk.triangles.push_back(setup);
+    for (auto ty = setup.min_y / TILE_SIZE; ty <= setup.max_y / TILE_SIZE; ty++){
+      for (auto tx = setup.min_x / TILE_SIZE; tx <= setup.max_x / TILE_SIZE; tx++){
+        chunk.bins[ty * tiles_x + tx].push_back(id);
+      }
+    }
+  }
+}
+
+// Rasterize the binned triangles of one tile. Chunks are visited in order, so
+// the result does not depend on scheduling. Edge functions are stepped
+// incrementally along each row and the tile keeps its own depth buffer with
+// the closest 1/z per pixel. Tiles cover disjoint pixels, so no locks are needed
+void rasterizeTile(Camera& camera, std::vector<BinChunk>& chunks, int tiles_x, int tile_x, int tile_y){
+  int x0 = tile_x * TILE_SIZE;
+  int y0 = tile_y * TILE_SIZE;
+  int x1 = std::min(x0 + TILE_SIZE, camera.width) - 1;
+  int y1 = std::min(y0 + TILE_SIZE, camera.height) - 1;
+  double depth_buffer[TILE_SIZE * TILE_SIZE] = {0};
+  for (auto& chunk : chunks){
+    for (auto id : chunk.bins[tile_y * tiles_x + tile_x]){
+      auto& triangle = chunk.triangles[id];
+      int min_x = std::max(x0, triangle.min_x);
+      int max_x = std::min(x1, triangle.max_x);
+      int min_y = std::max(y0, triangle.min_y);
+      int max_y = std::min(y1, triangle.max_y);
+      for (auto y = min_y; y <= max_y; y++){
+        double e0 = triangle.a[0] * min_x + triangle.b[0] * y + triangle.c[0];
+        double e1 = triangle.a[1] * min_x + triangle.b[1] * y + triangle.c[1];
+        double e2 = triangle.a[2] * min_x + triangle.b[2] * y + triangle.c[2];
+        double inv_z = triangle.inv_z_x * min_x + triangle.inv_z_y * y + triangle.inv_z_0;
+        for (auto x = min_x; x <= max_x; x++){
+          if (e0 >= 0 && e1 >= 0 && e2 >= 0){
+            auto& depth = depth_buffer[(y - y0) * TILE_SIZE + (x - x0)];
+            // Larger 1/z is closer
+            if (inv_z > depth){
+              depth = inv_z;
+              camera.setPixel(x, y, triangle.color);
+            }
+          }
+          e0 += triangle.a[0];
+          e1 += triangle.a[1];
+          e2 += triangle.a[2];
+          inv_z += triangle.inv_z_x;
+        }
+      }
+    }
+  }
+}
+
 
 int main(){
   auto camera = Camera{200, 200, 5, 0.0078125}; //0.125};
-  auto meshes = std::vector<Mesh>{}; //unitCircleTetrahedron()};
+  auto scene = Scene{};
   // Create circle
 
   std::cout << "Creating circle" << std::endl;
   auto sphere = sphereBySplittingEdges(3);
-  std::cout << "Circle created with " << sphere.get_faces().size() << " faces" << std::endl;
-  // Move by 20 away from camera
-  sphere.displace(Vertex3D(0, 0, 8));
+  std::cout << "Circle created with " << sphere.get_face_count() << " faces" << std::endl;
   // Get sample vertex of first face
-  auto face = sphere.get_face(0);
-  for (auto vertex : face.vertices){
+  auto face = sphere.get_face_view(0);
+  for (auto i = 0; i < face.size(); i++){
+    auto vertex = face.vertex(i);
     std::cout << "Vertex: (" << vertex.x << ", " << vertex.y << ", " << vertex.z << ")" << std::endl;
   }
 
-  meshes.push_back(sphere);
+  std::cout << "Baking triangles" << std::endl;
+  auto sphere_id = scene.add_mesh(sphere);
+  // Move by 8 away from camera
+  scene.add_instance(sphere_id, Transform3D::translation(Vertex3D(0, 0, 8)));
 
-  std::cout << "Sorting" << std::endl;
-  auto faces_distance = std::vector<std::pair<double, Face3D>>{};
-  for (auto mesh : meshes){
-    for (auto face : mesh.get_faces()){
-      auto midpoint = face.get_midpoint();
-      // If midpoint is behind camera, skip
-      if (midpoint.z < camera.distance){
-        continue;
-      }
-      auto distance = midpoint.magnitude();
-      faces_distance.push_back(std::make_pair(distance, face));
+  auto pool = TaskPool();
+  std::cout << "Using " << pool.get_thread_count() << " threads" << std::endl;
+
+  std::cout << "Binning triangles" << std::endl;
+  int tiles_x = (camera.width + TILE_SIZE - 1) / TILE_SIZE;
+  int tiles_y = (camera.height + TILE_SIZE - 1) / TILE_SIZE;
+  // World space copies of the visible triangles of every instance
+  auto records = std::vector<TriangleRecord>{};
+  for (auto i = 0; i < scene.get_instance_count(); i++){
+    auto& instance = scene.get_instance(i);
+    auto& baked = scene.get_baked(instance.mesh);
+    auto visible = cull_triangles(baked, camera.getFrustum(), CULL_ALL, instance.transform);
+    std::cout << visible.size() << " of " << baked.size() << " triangles after culling" << std::endl;
+    for (auto id : visible){
+      records.push_back(instance.transform.apply(baked.get_triangle(id)));
     }
   }
-  // Sort by distance. Furthest first
-  std::sort(faces_distance.begin(), faces_distance.end(), [](auto a, auto b){
-    return a.first > b.first;
-  });
-  // Get faces
-  auto faces = std::vector<Face3D>{};
-  for (auto pair : faces_distance){
-    faces.push_back(pair.second);
+  int chunk_count = (records.size() + BIN_CHUNK_SIZE - 1) / BIN_CHUNK_SIZE;
+  auto chunks = std::vector<BinChunk>(chunk_count);
+  for (auto i = 0; i < chunk_count; i++){
+    chunks[i].bins.resize(tiles_x * tiles_y);
+    int first = i * BIN_CHUNK_SIZE;
+    int last = std::min<int>(first + BIN_CHUNK_SIZE, records.size());
+    pool.submit([&, i, first, last](){ binChunk(camera, records, first, last, tiles_x, chunks[i]); });
   }
-
-
-
+  pool.wait();
+  int on_film = 0;
+  for (auto& chunk : chunks){
+    on_film += chunk.triangles.size();
+  }
+  std::cout << on_film << " triangles on film" << std::endl;
 
   std::cout << "Rendering" << std::endl;
   // Render
-  int count = 0;
-  int max = faces.size();
-  // Get number of steps that equal 1%
-  int step = max / 100.0;
-  for (auto face : faces){
-    // Output progress bar every 1%
-    if (count % step == 0){
-      std::cout << "Progress: " << count / step  << "%" << "(" << count << "/" << max << ")" << std::endl;
-    }
-    count++;
-
-    // Get projection of each vertex
-    std::vector<Point2D> points;
-    for (auto vertex : face.vertices){
-      auto point = camera.projectToFilm(vertex);
-      points.push_back(point);
-    }
-    // Get bounding box
-    double min_x = std::numeric_limits<double>::max();
-    double min_y = std::numeric_limits<double>::max();
-    double max_x = std::numeric_limits<double>::min();
-    double max_y = std::numeric_limits<double>::min();
-    for (auto point : points){
-      min_x = std::min(min_x, point.x);
-      min_y = std::min(min_y, point.y);
-      max_x = std::max(max_x, point.x);
-      max_y = std::max(max_y, point.y);
+  std::atomic<int> done(0);
+  for (auto ty = 0; ty < tiles_y; ty++){
+    for (auto tx = 0; tx < tiles_x; tx++){
+      pool.submit([&, tx, ty](){
+        rasterizeTile(camera, chunks, tiles_x, tx, ty);
+        done++;
+      });
     }
-    // Draw face
-    for (auto x = min_x; x < max_x; x++){
-      for (auto y = min_y; y < max_y; y++){
-        // Check if point is inside convex_polygon
-        auto p = camera.getFilmPoint(x, y);
-        if (inside_convex_polygon(points, p)){
-          // Get previous color
-          auto old_color = camera.getPixel(x, y);
-          if (old_color.r == 0 && old_color.b == 0 && old_color.g == 0){
-            std::cout << "First write on " << x << ", " << y << std::endl;
-            std::cout << "Vertexes: " << std::endl;
-            for (auto point : points){
-              std::cout << "(" << point.x << ", " << point.y << ")" << std::endl;
-            }
-          }
-          else {
-            std::cout << "Overwriting on " << x << ", " << y << std::endl;
-          }
-          // Get color of face
-          auto color = RGB{255, 255, 255};
-          // Normal
-          auto normal = face.get_normal();
-          // Ray from 0,0,0 to center of face
-          auto ray = face.get_midpoint();
-          // Get intesity color
-          auto cos_angle = dot_product(normal, ray) / (normal.magnitude() * ray.magnitude());
-          // If is positive, ignore
-          color = color * std::abs(cos_angle);
-          // Draw pixel
-          camera.setPixel(x, y, color);
-        }
-      }
+  }
+  // Report progress from the counter while the workers render
+  int max = tiles_x * tiles_y;
+  int last_percent = -1;
+  while (done < max){
+    int percent = 100.0 * done / max;
+    if (percent != last_percent){
+      std::cout << "Progress: " << percent << "%" << "(" << done << "/" << max << " tiles)" << std::endl;
+      last_percent = percent;
     }
-  
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
   }
+  pool.wait();
+  std::cout << "Progress: 100%" << "(" << max << "/" << max << " tiles)" << std::endl;
   // Save
-  camera.savePGM("outputs/pintor.ppm");
+  camera.savePPM("outputs/pintor.ppm");
+  camera.savePNG("outputs/pintor.png");
 }
\ No newline at end of file
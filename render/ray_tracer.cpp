@@ -4,8 +4,15 @@
 #include <optional>
 #include <limits>
 #include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
 #include "mesh.h"
+#include "framebuffer.h"
 #include "3d.h"
+#include "scene.h"
+#include "parallel.h"
 //#include "SplittingEdges.h"
 
 
@@ -30,125 +37,250 @@ struct RGB{
   }
 };
 
+// Deterministic jitter in [0, 1) for sample s of pixel (px, py), so every pass
+// and every thread count gives the same image
+double sampleJitter(int px, int py, int s){
+  std::uint32_t h = px * 73856093u ^ py * 19349663u ^ s * 83492791u;
+  h ^= h >> 16;
+  h *= 0x7feb352du;
+  h ^= h >> 15;
+  h *= 0x846ca68bu;
+  h ^= h >> 16;
+  return (h >> 8) / 16777216.0;
+}
+
 struct Camera{
   int width, height;
   int distance;
   double scale;
-  std::vector<std::vector<RGB>> pixels;
+  // Stratified anti-aliasing: each pixel is split in samples_per_axis^2 cells
+  // and gets one ray through a jittered point of every cell. 1 gives the single
+  // ray through the pixel corner
+  int samples_per_axis;
+  // Filtered samples, 0 to 255 per channel
+  render::Framebuffer<float> film;
 
-  Camera(int width, int height, double distance, double scale=0.25) : width(width), height(height), distance(distance), scale(scale)
+  Camera(int width, int height, double distance, double scale=0.25, int samples_per_axis=2) : width(width), height(height), distance(distance), scale(scale), samples_per_axis(samples_per_axis), film(width, height)
   {
-    // Initialize pixels
-    pixels = std::vector<std::vector<RGB>>(width, std::vector<RGB>(height, RGB{0, 0, 0}));
   }
 
 
-  Line3D getRay(int px, int py){
+  // Ray through film point (fx, fy) in pixel units, pixel (px, py) is at (px, py)
+  Line3D getRay(double fx, double fy){
     // Get film point
-    double x = (px - width / 2.0) * scale;
-    double y = (py - height / 2.0) * scale;
+    double x = (fx - width / 2.0) * scale;
+    double y = (fy - height / 2.0) * scale;
     auto dir = Vertex3D(x, y, distance);
     // direction
     auto origin = Vertex3D(0, 0, 0);
     return Line3D(origin, dir);
   }
 
-  void setPixel(int px, int py, RGB color){
-    pixels[px][py] = color;
+  int getSampleCount(){
+    return samples_per_axis * samples_per_axis;
   }
 
-  RGB getPixel(int px, int py){
-    return pixels[px][py];
-  }
-
-  void savePGM(std::string filename){
-    std::ofstream file;
-    file.open(filename);
-    file << "P3\n";
-    file << width << " " << height << "\n";
-    file << "255\n";
-    for (auto x = 0; x < width; x++){
-      for (auto y = 0; y < height; y++){
-        auto color = pixels[x][y];
-        file << (int) color.r << " " << (int) color.g << " " << (int) color.b << "\n";
+  // The rays of pixel (px, py), one per cell. Cells cover the pixel area
+  // centered on its film point
+  void getSampleRays(int px, int py, std::vector<Line3D>& rays){
+    rays.clear();
+    if (samples_per_axis == 1){
+      rays.push_back(getRay((double) px, (double) py));
+      return;
+    }
+    for (auto sy = 0; sy < samples_per_axis; sy++){
+      for (auto sx = 0; sx < samples_per_axis; sx++){
+        int s = sy * samples_per_axis + sx;
+        double fx = px - 0.5 + (sx + sampleJitter(px, py, 2 * s)) / samples_per_axis;
+        double fy = py - 0.5 + (sy + sampleJitter(px, py, 2 * s + 1)) / samples_per_axis;
+        rays.push_back(getRay(fx, fy));
       }
     }
-    file.close();
+  }
+
+  ViewFrustum getFrustum(){
+    // Film extents seen by the pixel grid
+    return ViewFrustum{(double) distance, width / 2.0 * scale, height / 2.0 * scale};
+  }
+
+  void setPixel(int px, int py, RGB color){
+    // Channels are truncated when saved, like the previous text output
+    film.set_pixel(px, py, color.r, color.g, color.b);
+  }
+
+  RGB getPixel(int px, int py){
+    auto pixel = film.get_pixel(px, py);
+    return RGB{(double) pixel[0], (double) pixel[1], (double) pixel[2]};
+  }
+
+  void savePPM(std::string filename){
+    film.save_ppm(filename);
+  }
+
+  void savePNG(std::string filename){
+    film.save_png(filename);
   }
 };
 
+// Color of the closest hit along a camera ray. Black on a miss
+RGB traceRay(Scene& scene, const Line3D& ray){
+  // Find closest intersection. Ray starts at the origin and reaches the
+  // film (z = camera.distance) at t = 1, so hits behind the film have t < 1
+  auto hit_opt = scene.intersect(ray, 1.0);
+  if (!hit_opt.has_value()){
+    return RGB{0, 0, 0};
+  }
+  // Multiply by cos of angle between ray and normal
+  auto normal = hit_opt.value().normal;
+  auto direction = ray.direction;
+  auto cos_angle = dot_product(normal, direction) / (normal.magnitude() * direction.magnitude());
+  return RGB{255, 255, 255} * std::abs(cos_angle);
+}
+
+// Box filter over the samples of pixel (px, py): each sample weighs 1 / count
+// in its own pixel only, so the cost per pixel is fixed and tiles stay disjoint.
+// rays is a buffer reused by the caller
+RGB tracePixel(Camera& camera, Scene& scene, int px, int py, std::vector<Line3D>& rays){
+  camera.getSampleRays(px, py, rays);
+  auto color = RGB{0, 0, 0};
+  for (auto& ray : rays){
+    color = color + traceRay(scene, ray);
+  }
+  return color * (1.0 / rays.size());
+}
+
+// Square block of pixels rendered by one task
+const int TILE_SIZE = 16;
+
+// Progressive mode traces the film in interleaved passes, from one pixel every
+// preview step to every pixel. Each traced pixel also fills the block up to the
+// next pixel of its pass, so the first pass already covers the film with
+// 1 / step^2 of the work. Every pixel is traced once, the last pass leaves the
+// same image as a single full pass. A step of 1 is a single full pass
+const int PREVIEW_STEP = 8;
+// Least time between two preview frames. Tiles are submitted in batches of
+// TILES_PER_THREAD per thread and a frame is saved between batches once the
+// interval has passed, so frames keep coming during long passes
+const int PREVIEW_INTERVAL_MS = 100;
+const int TILES_PER_THREAD = 4;
+const std::string PREVIEW_FILE = "outputs/render_preview.ppm";
+
+// Pass of a tile over the pixels with coordinates multiple of step. Pixels on
+// the grid of the previous pass (2 * step) are already traced unless this is
+// the first pass. Tiles and blocks cover disjoint pixels, so workers write to
+// the camera without locks
+void renderTile(Camera& camera, Scene& scene, int x0, int y0, int step, bool first, std::atomic<int>& done){
+  int x1 = std::min(x0 + TILE_SIZE, camera.width);
+  int y1 = std::min(y0 + TILE_SIZE, camera.height);
+  int traced = 0;
+  auto rays = std::vector<Line3D>{};
+  rays.reserve(camera.getSampleCount());
+  for (auto x = x0; x < x1; x += step){
+    for (auto y = y0; y < y1; y += step){
+      if (!first && x % (2 * step) == 0 && y % (2 * step) == 0){
+        continue;
+      }
+      auto color = tracePixel(camera, scene, x, y, rays);
+      for (auto bx = x; bx < std::min(x + step, x1); bx++){
+        for (auto by = y; by < std::min(y + step, y1); by++){
+          camera.setPixel(bx, by, color);
+        }
+      }
+      traced++;
+    }
+  }
+  done += traced;
+}
 
 
-int main(){
-  auto camera = Camera{200, 200, 5, 0.0078125}; //0.125};
-  auto meshes = std::vector<Mesh>{}; //unitCircleTetrahedron()};
+// Usage: RayTracer.exe [samples per axis] [preview step] [preview interval ms]
+// Defaults are 2, PREVIEW_STEP and PREVIEW_INTERVAL_MS. The step is rounded down
+// to a power of two up to TILE_SIZE
+int main(int argc, char** argv){
+  int samples_per_axis = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2;
+  int requested_step = argc > 2 ? std::atoi(argv[2]) : PREVIEW_STEP;
+  int preview_step = 1;
+  while (preview_step * 2 <= requested_step && preview_step * 2 <= TILE_SIZE){
+    preview_step *= 2;
+  }
+  int preview_interval_ms = argc > 3 ? std::max(0, std::atoi(argv[3])) : PREVIEW_INTERVAL_MS;
+  auto camera = Camera{200, 200, 5, 0.0078125, samples_per_axis}; //0.125};
+  auto scene = Scene{};
   std::cout << "Loading ply" << std::endl;
   auto sphere = Mesh("outputs/ck.ply");
-  std::cout << "Loaded mesh with " << sphere.get_faces().size() << " faces" << std::endl;
-  // Move by 5 away from camera
-  sphere.displace(Vertex3D(0, 0, 10));
+  std::cout << "Loaded mesh with " << sphere.get_face_count() << " faces" << std::endl;
   // Create circle
   /*
   std::cout << "Creating circle" << std::endl;
   auto sphere = sphereBySplittingEdges(3);
-  std::cout << "Circle created with " << sphere.get_faces().size() << " faces" << std::endl;
-  // Move by 20 away from camera
-  sphere.displace(Vertex3D(0, 0, 10));
+  std::cout << "Circle created with " << sphere.get_face_count() << " faces" << std::endl;
   // Get sample vertex of first face
-  auto face = sphere.get_face(0);
-  for (auto vertex : face.vertices){
+  auto face = sphere.get_face_view(0);
+  for (auto i = 0; i < face.size(); i++){
+    auto vertex = face.vertex(i);
     std::cout << "Vertex: (" << vertex.x << ", " << vertex.y << ", " << vertex.z << ")" << std::endl;
   }
   */
 
-  meshes.push_back(sphere);
+  // Baked with its BVH once, placed by instances
+  auto sphere_id = scene.add_mesh(sphere);
+  // Move by 10 away from camera
+  scene.add_instance(sphere_id, Transform3D::translation(Vertex3D(0, 0, 10)));
+
+  std::cout << "Building scene" << std::endl;
+  // Only primary rays are traced, so instances out of view are left out and
+  // triangles facing away from the eye are never hit
+  scene.build(camera.getFrustum());
+  scene.set_cull_back_faces(true);
   
   std::cout << "Rendering" << std::endl;
   // Render
-  int count = 0;
+  auto pool = TaskPool();
+  std::cout << "Using " << pool.get_thread_count() << " threads" << std::endl;
+  std::cout << "Using " << camera.getSampleCount() << " samples per pixel" << std::endl;
+  std::atomic<int> done(0);
   int max = camera.width * camera.height;
-  // Get number of steps that equal 1%
-  int step = max / 100;
-  for (auto x = 0; x < camera.width; x++){
-    for (auto y = 0; y < camera.height; y++){
-      // Output progress bar every 5%
-      if (count % step == 0){
-        std::cout << "Progress: " << count / step  << "%" << "(" << count << "/" << max << ")" << std::endl;
+  int last_percent = -1;
+  auto start = std::chrono::steady_clock::now();
+  auto last_preview = start;
+  int batch_size = pool.get_thread_count() * TILES_PER_THREAD;
+  for (auto step = preview_step; step >= 1; step /= 2){
+    std::vector<std::pair<int, int>> tiles;
+    for (auto x = 0; x < camera.width; x += TILE_SIZE){
+      for (auto y = 0; y < camera.height; y += TILE_SIZE){
+        tiles.push_back({x, y});
       }
-      count++;
-      // Draw ray
-      auto ray = camera.getRay(x, y);
-      // Find intersection
-      auto min_distance = std::numeric_limits<double>::max();
-      for (auto mesh : meshes){
-        for (auto face : mesh.get_faces()){
-          auto intersection_opt = face.intersect(ray);
-          if (intersection_opt.has_value()){
-            auto intersection_point = intersection_opt.value();
-            // If intersection is behind the camera, ignore
-            if (intersection_point.z < camera.distance){
-              std::cout << "Intersection behind camera at:" << intersection_point.x << ", " << intersection_point.y << ", " << intersection_point.z << std::endl;
-              continue;
-            }
-            auto distance = (ray.point - intersection_point).magnitude();
-            if (distance < min_distance){
-              min_distance = distance;
-              // Get color
-              auto color = RGB{255, 255, 255};
-              // Multiply by cos of angle between ray and normal
-              auto normal = face.get_normal();
-              auto direction = ray.direction;
-              auto cos_angle = dot_product(normal, direction) / (normal.magnitude() * direction.magnitude());
-              color = color * std::abs(cos_angle);
-              // set pixel
-              camera.setPixel(x, y, color);
-            }
-          }
-        }
+    }
+    // Batches stay inside a pass, so a tile never runs two passes at once
+    for (size_t begin = 0; begin < tiles.size(); begin += batch_size){
+      size_t end = std::min(begin + batch_size, tiles.size());
+      for (size_t t = begin; t < end; t++){
+        int x = tiles[t].first, y = tiles[t].second;
+        pool.submit([&, x, y, step](){ renderTile(camera, scene, x, y, step, step == preview_step, done); });
+      }
+      pool.wait();
+      int percent = 100.0 * done / max;
+      if (percent != last_percent){
+        std::cout << "Progress: " << percent << "%" << "(" << done << "/" << max << ")" << std::endl;
+        last_percent = percent;
+      }
+      // Preview between batches, when the film is not being written. The first
+      // one as soon as the first pass covers the film
+      bool pass_done = end == tiles.size();
+      auto now = std::chrono::steady_clock::now();
+      bool due = now - last_preview >= std::chrono::milliseconds(preview_interval_ms) || (step == preview_step && pass_done);
+      if (preview_step > 1 && !(step == 1 && pass_done) && due){
+        camera.savePPM(PREVIEW_FILE);
+        last_preview = now;
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count();
+        std::cout << "Preview (1 pixel in " << step << "x" << step << ") after " << elapsed << "ms" << std::endl;
       }
     }
   }
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "Progress: 100%" << "(" << max << "/" << max << ") after " << elapsed << "ms" << std::endl;
   // Save
-  camera.savePGM("outputs/render.ppm");
+  camera.savePPM("outputs/render.ppm");
+  camera.savePNG("outputs/render.png");
 
 }
\ No newline at end of file